@@ -0,0 +1,459 @@
+/**************************************************************************
+ *   ds_perf_bench.c  --                                                  *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+/*
+ * Runs each library operation inside a group of hardware performance counters
+ * (cycles, instructions, L1D/LLC misses, branch misses, dTLB misses) and reports them per element.
+ * Counters the host does not expose (containers, VMs, perf_event_paranoid) are reported as "-",
+ * and the wall-clock time is always reported.
+ * Usage: ds_perf_bench [elements]
+ */
+
+#define _GNU_SOURCE
+
+#include <time.h>
+
+#include "../lists/dynamic_array.h"
+#include "../lists/singly_linked_list.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* The counters of a group, in reporting order */
+typedef enum perf_counter
+{
+    COUNTER_CYCLES,
+    COUNTER_INSTRUCTIONS,
+    COUNTER_L1D_MISSES,
+    COUNTER_LLC_MISSES,
+    COUNTER_BRANCH_MISSES,
+    COUNTER_DTLB_MISSES,
+    COUNTER_COUNT
+} perf_counter;
+
+static const char* counter_names[COUNTER_COUNT] = {
+    "cycles", "instr", "L1D-miss", "LLC-miss", "br-miss", "dTLB-miss"
+};
+
+/* A group of counters that are enabled and disabled together */
+typedef struct perf_group
+{
+    /* The file descriptor of each counter, -1 if it could not be opened */
+    int fds[COUNTER_COUNT];
+    /* The descriptor all other counters are grouped under */
+    int leader;
+} perf_group;
+
+/* The counts of one measured run, negative when unavailable */
+typedef struct perf_sample
+{
+    double counts[COUNTER_COUNT];
+    double nanoseconds;
+} perf_sample;
+
+/* A measured operation: setup and teardown run outside the counted region */
+typedef struct perf_operation
+{
+    const char* name;
+    void (*setup)(size_t elements);
+    void (*run)(size_t elements);
+    void (*teardown)(void);
+    /* The number of elements the run touches, used to normalize the counts */
+    size_t (*work)(size_t elements);
+} perf_operation;
+
+#ifdef __linux__
+
+static uint64_t cache_config(const uint64_t cache, const uint64_t op, const uint64_t result)
+{
+    return cache | (op << 8) | (result << 16);
+}
+
+static int open_counter(const perf_counter counter, const int group_fd)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = group_fd == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    switch (counter)
+    {
+    case COUNTER_CYCLES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case COUNTER_INSTRUCTIONS:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case COUNTER_L1D_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cache_config(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                   PERF_COUNT_HW_CACHE_RESULT_MISS);
+        break;
+    case COUNTER_LLC_MISSES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    case COUNTER_BRANCH_MISSES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    case COUNTER_DTLB_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cache_config(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                                   PERF_COUNT_HW_CACHE_RESULT_MISS);
+        break;
+    default:
+        return -1;
+    }
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0UL);
+}
+
+/* Opens as many counters as the host allows, the first one that opens leads the group */
+static void perf_group_open(perf_group* group)
+{
+    group->leader = -1;
+
+    for (int i = 0; i < COUNTER_COUNT; ++i)
+    {
+        group->fds[i] = open_counter((perf_counter)i, group->leader);
+
+        if ((group->fds[i] != -1) && (group->leader == -1))
+        {
+            group->leader = group->fds[i];
+        }
+    }
+}
+
+static void perf_group_close(perf_group* group)
+{
+    for (int i = 0; i < COUNTER_COUNT; ++i)
+    {
+        if (group->fds[i] != -1)
+        {
+            close(group->fds[i]);
+        }
+    }
+}
+
+static void perf_group_start(const perf_group* group)
+{
+    if (group->leader != -1)
+    {
+        ioctl(group->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(group->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+static void perf_group_stop(const perf_group* group, perf_sample* sample)
+{
+    if (group->leader != -1)
+    {
+        ioctl(group->leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    for (int i = 0; i < COUNTER_COUNT; ++i)
+    {
+        /* value, time enabled, time running */
+        uint64_t values[3];
+        sample->counts[i] = -1.0;
+
+        if ((group->fds[i] == -1) || (read(group->fds[i], values, sizeof(values)) != sizeof(values)) ||
+            (values[2] == 0))
+        {
+            continue;
+        }
+
+        /* Scale up counts that were multiplexed with other events */
+        sample->counts[i] = (double)values[0] * ((double)values[1] / (double)values[2]);
+    }
+}
+
+#else
+
+static void perf_group_open(perf_group* group)
+{
+    group->leader = -1;
+
+    for (int i = 0; i < COUNTER_COUNT; ++i)
+    {
+        group->fds[i] = -1;
+    }
+}
+
+static void perf_group_close(perf_group* group)
+{
+    (void)group;
+}
+
+static void perf_group_start(const perf_group* group)
+{
+    (void)group;
+}
+
+static void perf_group_stop(const perf_group* group, perf_sample* sample)
+{
+    (void)group;
+
+    for (int i = 0; i < COUNTER_COUNT; ++i)
+    {
+        sample->counts[i] = -1.0;
+    }
+}
+
+#endif
+
+/* The containers shared by the setup, run and teardown of an operation */
+static dynamic_array* bench_array;
+static singly_linked_list* bench_list;
+static volatile uint64_t bench_sink;
+
+static uint64_t next_random(uint64_t* state)
+{
+    /* xorshift64 */
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static int compare_uint64(const void* a, const void* b)
+{
+    const uint64_t x = *(const uint64_t*)a;
+    const uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static size_t work_elements(const size_t elements)
+{
+    return elements;
+}
+
+static void setup_nothing(const size_t elements)
+{
+    (void)elements;
+}
+
+static void setup_array(const size_t elements)
+{
+    bench_array = dynarr_initialize_sized(elements, sizeof(uint64_t));
+    uint64_t state = 88172645463325252ULL;
+
+    for (size_t i = 0; i < elements; ++i)
+    {
+        const uint64_t value = next_random(&state) >> 1;
+        dynarr_add(bench_array, &value, sizeof(value));
+    }
+}
+
+static void setup_list(const size_t elements)
+{
+    bench_list = slist_initialize(sizeof(uint64_t));
+
+    for (uint64_t i = 0; i < elements; ++i)
+    {
+        slist_add_last(bench_list, &i, sizeof(i));
+    }
+}
+
+static void teardown_containers(void)
+{
+    dynarr_destroy(bench_array);
+    slist_destroy(bench_list);
+    bench_array = nullptr;
+    bench_list = nullptr;
+}
+
+static void run_dynarr_add(const size_t elements)
+{
+    bench_array = dynarr_initialize_empty(sizeof(uint64_t));
+
+    for (uint64_t i = 0; i < elements; ++i)
+    {
+        dynarr_add(bench_array, &i, sizeof(i));
+    }
+}
+
+static void run_dynarr_get(const size_t elements)
+{
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < elements; ++i)
+    {
+        uint64_t value;
+        dynarr_get(bench_array, i, &value, sizeof(value));
+        sum += value;
+    }
+
+    bench_sink = sum;
+}
+
+static void run_dynarr_index_of(const size_t elements)
+{
+    (void)elements;
+
+    /* Every value has its top bit clear, so this scans the whole array */
+    const uint64_t missing = UINT64_MAX;
+    size_t index;
+    bench_sink = dynarr_index_of(bench_array, &missing, sizeof(missing), &index);
+}
+
+static void run_dynarr_sort(const size_t elements)
+{
+    (void)elements;
+    dynarr_sort(bench_array, compare_uint64);
+}
+
+static void run_dynarr_remove_last(const size_t elements)
+{
+    for (size_t i = elements; i > 0; --i)
+    {
+        uint64_t value;
+        dynarr_remove_at(bench_array, i - 1, &value, sizeof(value));
+    }
+}
+
+static void run_slist_add_last(const size_t elements)
+{
+    bench_list = slist_initialize(sizeof(uint64_t));
+
+    for (uint64_t i = 0; i < elements; ++i)
+    {
+        slist_add_last(bench_list, &i, sizeof(i));
+    }
+}
+
+static void run_slist_get_at(const size_t elements)
+{
+    /* A single lookup of the last element walks every node */
+    const uint64_t* value = slist_get_at(bench_list, elements - 1);
+    bench_sink = value ? *value : 0;
+}
+
+static void run_slist_remove_first(const size_t elements)
+{
+    for (size_t i = 0; i < elements; ++i)
+    {
+        free(slist_remove_first(bench_list));
+    }
+}
+
+static const perf_operation operations[] = {
+    {"dynarr_add", setup_nothing, run_dynarr_add, teardown_containers, work_elements},
+    {"dynarr_get", setup_array, run_dynarr_get, teardown_containers, work_elements},
+    {"dynarr_index_of", setup_array, run_dynarr_index_of, teardown_containers, work_elements},
+    {"dynarr_sort", setup_array, run_dynarr_sort, teardown_containers, work_elements},
+    {"dynarr_remove_at", setup_array, run_dynarr_remove_last, teardown_containers, work_elements},
+    {"slist_add_last", setup_nothing, run_slist_add_last, teardown_containers, work_elements},
+    {"slist_get_at", setup_list, run_slist_get_at, teardown_containers, work_elements},
+    {"slist_remove_first", setup_list, run_slist_remove_first, teardown_containers, work_elements},
+};
+
+static double elapsed_ns(const struct timespec* start, const struct timespec* end)
+{
+    return ((double)(end->tv_sec - start->tv_sec) * 1e9) + (double)(end->tv_nsec - start->tv_nsec);
+}
+
+static void print_count(const double count, const double work)
+{
+    if (count < 0)
+    {
+        printf(" %10s", "-");
+    }
+    else
+    {
+        printf(" %10.3f", count / work);
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const size_t elements = (argc > 1) ? strtoull(argv[1], nullptr, 10) : ((size_t)1 << 20);
+
+    if (elements == 0)
+    {
+        fprintf(stderr, "usage: %s [elements]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    perf_group group;
+    perf_group_open(&group);
+
+    if (group.leader == -1)
+    {
+        fprintf(stderr, "hardware counters unavailable, reporting wall-clock time only\n");
+    }
+
+    printf("%zu elements, counts per element\n", elements);
+    printf("%-20s %10s", "operation", "ns");
+
+    for (int i = 0; i < COUNTER_COUNT; ++i)
+    {
+        printf(" %10s", counter_names[i]);
+    }
+
+    printf(" %10s\n", "IPC");
+
+    for (size_t i = 0; i < sizeof(operations) / sizeof(operations[0]); ++i)
+    {
+        const perf_operation* operation = &operations[i];
+        perf_sample sample;
+        struct timespec start, end;
+
+        operation->setup(elements);
+
+        perf_group_start(&group);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        operation->run(elements);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        perf_group_stop(&group, &sample);
+
+        operation->teardown();
+
+        const double work = (double)operation->work(elements);
+        sample.nanoseconds = elapsed_ns(&start, &end);
+
+        printf("%-20s %10.3f", operation->name, sample.nanoseconds / work);
+
+        for (int c = 0; c < COUNTER_COUNT; ++c)
+        {
+            print_count(sample.counts[c], work);
+        }
+
+        const double cycles = sample.counts[COUNTER_CYCLES];
+        const double instructions = sample.counts[COUNTER_INSTRUCTIONS];
+
+        if ((cycles > 0) && (instructions >= 0))
+        {
+            printf(" %10.3f\n", instructions / cycles);
+        }
+        else
+        {
+            printf(" %10s\n", "-");
+        }
+    }
+
+    perf_group_close(&group);
+    return EXIT_SUCCESS;
+}
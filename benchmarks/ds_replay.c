@@ -0,0 +1,534 @@
+/**************************************************************************
+ *   ds_replay.c  --  This file is part of Data Structures Library.       *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+/*
+ * Re-runs a trace recorded by a DS_TRACE build against the library and reports how long it took.
+ * The element values are synthetic: searches look up the element found at the recorded index,
+ * or a value that is never added when the original search failed, so they scan as far as the original did.
+ * Calls on containers created before recording started are skipped.
+ * Usage: ds_replay [-b] trace_file
+ *   -b  also time every call and report the time spent per operation
+ */
+
+#define DS_TRACE_NO_SHIM
+
+#include <time.h>
+
+#include "../lists/ds_trace.h"
+
+/* A container created by the trace */
+typedef struct replay_container
+{
+    dynamic_array* array;
+    singly_linked_list* list;
+    dynamic_array_snapshot* snapshot;
+    size_t data_size;
+} replay_container;
+
+/* The time spent in each operation */
+typedef struct replay_op_stats
+{
+    uint64_t calls;
+    double nanoseconds;
+} replay_op_stats;
+
+/* The live containers, indexed by trace id */
+static replay_container* containers;
+static size_t container_capacity;
+
+/* The element passed to and received from the containers */
+static unsigned char* element;
+static size_t element_capacity;
+static uint64_t next_value;
+
+/* The element size of the array being sorted */
+static size_t sort_data_size;
+
+static uint64_t skipped;
+
+static replay_container* container_at(const uint32_t id)
+{
+    if (id == 0)
+    {
+        return nullptr;
+    }
+
+    if (id >= container_capacity)
+    {
+        size_t new_capacity = container_capacity ? container_capacity : 64;
+
+        while (new_capacity <= id)
+        {
+            new_capacity <<= 1;
+        }
+
+        replay_container* resized = realloc(containers, new_capacity * sizeof(replay_container));
+
+        if (!resized)
+        {
+            return nullptr;
+        }
+
+        memset(resized + container_capacity, 0, (new_capacity - container_capacity) * sizeof(replay_container));
+        containers = resized;
+        container_capacity = new_capacity;
+    }
+
+    return &containers[id];
+}
+
+static bool reserve_element(const size_t data_size)
+{
+    if (data_size <= element_capacity)
+    {
+        return true;
+    }
+
+    unsigned char* resized = realloc(element, data_size);
+
+    if (!resized)
+    {
+        return false;
+    }
+
+    element = resized;
+    element_capacity = data_size;
+    return true;
+}
+
+/* Fills the element with a value that was not added before */
+static void make_value(const size_t data_size)
+{
+    memset(element, 0, data_size);
+    next_value++;
+    memcpy(element, &next_value, data_size < sizeof(next_value) ? data_size : sizeof(next_value));
+}
+
+/* Fills the element with the one at index, or with a value that is never added */
+static void make_search_key(const dynamic_array* array, const uint64_t index, const size_t data_size)
+{
+    if ((index == UINT64_MAX) || !dynarr_get(array, index, element, data_size))
+    {
+        memset(element, 0xFF, data_size);
+    }
+}
+
+static int compare_elements(const void* a, const void* b)
+{
+    return memcmp(a, b, sort_data_size);
+}
+
+/* Whether the container an operation works on exists */
+static bool has_target(const replay_container* target, const ds_trace_op op)
+{
+    if ((op >= DS_TRACE_DYNARR_SNAPSHOT_GET) && (op <= DS_TRACE_DYNARR_SNAPSHOT_DESTROY))
+    {
+        return target->snapshot;
+    }
+
+    if (((op >= DS_TRACE_SLIST_INITIALIZE) && (op <= DS_TRACE_SLIST_IS_EMPTY)) ||
+        ((op >= DS_TRACE_SLIST_SPLICE_LAST) && (op <= DS_TRACE_SLIST_SPLIT_AT)))
+    {
+        return target->list;
+    }
+
+    return target->array;
+}
+
+static void replay_record(const ds_trace_record* record)
+{
+    /* Growing the table moves it, so it is grown for the larger id before any entry is taken */
+    container_at((record->container > record->other) ? record->container : record->other);
+
+    replay_container* target = container_at(record->container);
+    replay_container* other = container_at(record->other);
+
+    if (!target)
+    {
+        skipped++;
+        return;
+    }
+
+    const bool creates = (record->op == DS_TRACE_DYNARR_INITIALIZE_EMPTY) ||
+        (record->op == DS_TRACE_DYNARR_INITIALIZE_SIZED) ||
+        (record->op == DS_TRACE_DYNARR_INITIALIZE_LARGE) ||
+        (record->op == DS_TRACE_DYNARR_INITIALIZE_FROM) ||
+        (record->op == DS_TRACE_SLIST_INITIALIZE) ||
+        (record->op == DS_TRACE_SLIST_INITIALIZE_FROM);
+
+    if (!creates && !has_target(target, record->op))
+    {
+        skipped++;
+        return;
+    }
+
+    dynamic_array* array = target->array;
+    singly_linked_list* list = target->list;
+    const size_t data_size = creates ? (size_t)record->size : target->data_size;
+
+    if (!reserve_element(data_size ? data_size : 1))
+    {
+        skipped++;
+        return;
+    }
+
+    switch (record->op)
+    {
+    case DS_TRACE_DYNARR_INITIALIZE_EMPTY:
+        target->array = dynarr_initialize_empty(data_size);
+        target->data_size = data_size;
+        break;
+    case DS_TRACE_DYNARR_INITIALIZE_SIZED:
+        target->array = dynarr_initialize_sized(record->index, data_size);
+        target->data_size = data_size;
+        break;
+    case DS_TRACE_DYNARR_INITIALIZE_LARGE:
+        target->array = dynarr_initialize_large(record->index, data_size, nullptr);
+        target->data_size = data_size;
+        break;
+    case DS_TRACE_DYNARR_INITIALIZE_FROM:
+        target->array = (other && other->array) ? dynarr_initialize_from(other->array, data_size) : nullptr;
+        target->data_size = data_size;
+        break;
+    case DS_TRACE_DYNARR_DESTROY:
+        dynarr_destroy(array);
+        target->array = nullptr;
+        break;
+    case DS_TRACE_DYNARR_GET:
+        dynarr_get(array, record->index, element, data_size);
+        break;
+    case DS_TRACE_DYNARR_GET_SUB_LIST:
+        if (other)
+        {
+            other->array = dynarr_get_sub_list(array, record->index, record->size);
+            other->data_size = data_size;
+        }
+        break;
+    case DS_TRACE_DYNARR_REMOVE_AT:
+        dynarr_remove_at(array, record->index, element, data_size);
+        break;
+    case DS_TRACE_DYNARR_REMOVE_ELEMENT:
+        make_search_key(array, record->index, data_size);
+        dynarr_remove_element(array, element, data_size);
+        break;
+    case DS_TRACE_DYNARR_REMOVE_ALL:
+        dynarr_remove_all(array, other ? other->array : nullptr);
+        break;
+    case DS_TRACE_DYNARR_REMOVE_RANGE:
+        dynarr_remove_range(array, record->index, record->size);
+        break;
+    case DS_TRACE_DYNARR_ADD:
+        make_value(data_size);
+        dynarr_add(array, element, data_size);
+        break;
+    case DS_TRACE_DYNARR_ADD_ALL:
+        dynarr_add_all(array, other ? other->array : nullptr);
+        break;
+    case DS_TRACE_DYNARR_INSERT:
+        make_value(data_size);
+        dynarr_insert(array, record->index, element, data_size);
+        break;
+    case DS_TRACE_DYNARR_SET:
+        make_value(data_size);
+        dynarr_set(array, record->index, element, data_size);
+        break;
+    case DS_TRACE_DYNARR_CONTAINS:
+        make_search_key(array, record->index, data_size);
+        dynarr_contains(array, element, data_size);
+        break;
+    case DS_TRACE_DYNARR_INDEX_OF:
+    {
+        size_t index;
+        make_search_key(array, record->index, data_size);
+        dynarr_index_of(array, element, data_size, &index);
+        break;
+    }
+    case DS_TRACE_DYNARR_LAST_INDEX_OF:
+    {
+        size_t index;
+        make_search_key(array, record->index, data_size);
+        dynarr_last_index_of(array, element, data_size, &index);
+        break;
+    }
+    case DS_TRACE_DYNARR_CLEAR:
+        dynarr_clear(array);
+        break;
+    case DS_TRACE_DYNARR_SIZE:
+        dynarr_size(array);
+        break;
+    case DS_TRACE_DYNARR_IS_EMPTY:
+        dynarr_is_empty(array);
+        break;
+    case DS_TRACE_DYNARR_DATA_SIZE:
+        dynarr_data_size(array);
+        break;
+    case DS_TRACE_DYNARR_ENSURE_CAPACITY:
+        dynarr_ensure_capacity(array, record->index);
+        break;
+    case DS_TRACE_DYNARR_TRIM_TO_SIZE:
+        dynarr_trim_to_size(array);
+        break;
+    case DS_TRACE_DYNARR_SORT:
+        sort_data_size = data_size;
+        dynarr_sort(array, compare_elements);
+        break;
+    case DS_TRACE_SLIST_INITIALIZE:
+        target->list = slist_initialize(data_size);
+        target->data_size = data_size;
+        break;
+    case DS_TRACE_SLIST_INITIALIZE_FROM:
+        target->list = (other && other->list) ? slist_initialize_from(other->list, data_size) : nullptr;
+        target->data_size = data_size;
+        break;
+    case DS_TRACE_SLIST_DESTROY:
+        slist_destroy(list);
+        target->list = nullptr;
+        break;
+    case DS_TRACE_SLIST_GET_FIRST:
+        slist_get_first(list);
+        break;
+    case DS_TRACE_SLIST_GET_LAST:
+        slist_get_last(list);
+        break;
+    case DS_TRACE_SLIST_GET_AT:
+        slist_get_at(list, record->index);
+        break;
+    case DS_TRACE_SLIST_GET_SUB_LIST:
+        if (other)
+        {
+            other->list = slist_get_sub_list(list, record->index, record->size);
+            other->data_size = data_size;
+        }
+        break;
+    case DS_TRACE_SLIST_REMOVE_FIRST:
+        free(slist_remove_first(list));
+        break;
+    case DS_TRACE_SLIST_REMOVE_LAST:
+        free(slist_remove_last(list));
+        break;
+    case DS_TRACE_SLIST_ADD_FIRST:
+        make_value(data_size);
+        slist_add_first(list, element, data_size);
+        break;
+    case DS_TRACE_SLIST_ADD_LAST:
+        make_value(data_size);
+        slist_add_last(list, element, data_size);
+        break;
+    case DS_TRACE_SLIST_CLEAR:
+        slist_clear(list);
+        break;
+    case DS_TRACE_SLIST_SIZE:
+        slist_size(list);
+        break;
+    case DS_TRACE_SLIST_IS_EMPTY:
+        slist_is_empty(list);
+        break;
+    case DS_TRACE_SLIST_SPLICE_LAST:
+        if (other && other->list)
+        {
+            slist_splice_last(list, other->list);
+        }
+        break;
+    case DS_TRACE_SLIST_SPLICE_AT:
+        if (other && other->list)
+        {
+            slist_splice_at(list, record->index, other->list);
+        }
+        break;
+    case DS_TRACE_SLIST_SPLIT_AT:
+        if (other)
+        {
+            other->list = slist_split_at(list, record->index);
+            other->data_size = data_size;
+        }
+        break;
+    case DS_TRACE_DYNARR_GET_AT:
+        dynarr_get_at(array, record->index);
+        break;
+    case DS_TRACE_DYNARR_DATA:
+        dynarr_data(array);
+        break;
+    case DS_TRACE_DYNARR_SNAPSHOT:
+        if (other)
+        {
+            other->snapshot = dynarr_snapshot(array);
+            other->data_size = data_size;
+        }
+        break;
+    case DS_TRACE_DYNARR_SNAPSHOT_GET:
+        dynarr_snapshot_get(target->snapshot, record->index, element, data_size);
+        break;
+    case DS_TRACE_DYNARR_SNAPSHOT_SIZE:
+        dynarr_snapshot_size(target->snapshot);
+        break;
+    case DS_TRACE_DYNARR_SNAPSHOT_DESTROY:
+        dynarr_snapshot_destroy(target->snapshot);
+        target->snapshot = nullptr;
+        break;
+    default:
+        skipped++;
+        break;
+    }
+}
+
+static double elapsed_ns(const struct timespec* start, const struct timespec* end)
+{
+    return ((double)(end->tv_sec - start->tv_sec) * 1e9) + (double)(end->tv_nsec - start->tv_nsec);
+}
+
+/* Reads the whole trace up front, so the replay is not timed together with the file reads */
+static ds_trace_record* load_trace(const char* path, size_t* out_count)
+{
+    ds_trace_reader* reader = ds_trace_reader_open(path);
+
+    if (!reader)
+    {
+        return nullptr;
+    }
+
+    size_t capacity = 1024;
+    size_t count = 0;
+    ds_trace_record* records = malloc(capacity * sizeof(ds_trace_record));
+
+    while (records)
+    {
+        if (count == capacity)
+        {
+            ds_trace_record* resized = realloc(records, 2 * capacity * sizeof(ds_trace_record));
+
+            if (!resized)
+            {
+                free(records);
+                records = nullptr;
+                break;
+            }
+
+            records = resized;
+            capacity *= 2;
+        }
+
+        if (!ds_trace_reader_next(reader, &records[count]))
+        {
+            break;
+        }
+
+        count++;
+    }
+
+    ds_trace_reader_close(reader);
+    *out_count = count;
+    return records;
+}
+
+int main(const int argc, char** argv)
+{
+    bool breakdown = false;
+    const char* path = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "-b"))
+        {
+            breakdown = true;
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+
+    if (!path)
+    {
+        fprintf(stderr, "usage: %s [-b] trace_file\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    size_t count = 0;
+    ds_trace_record* records = load_trace(path, &count);
+
+    if (!records)
+    {
+        fprintf(stderr, "%s: cannot read trace %s\n", argv[0], path);
+        return EXIT_FAILURE;
+    }
+
+    replay_op_stats op_stats[DS_TRACE_OP_COUNT] = {0};
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (breakdown)
+        {
+            struct timespec op_start, op_end;
+            clock_gettime(CLOCK_MONOTONIC, &op_start);
+            replay_record(&records[i]);
+            clock_gettime(CLOCK_MONOTONIC, &op_end);
+            op_stats[records[i].op].nanoseconds += elapsed_ns(&op_start, &op_end);
+        }
+        else
+        {
+            replay_record(&records[i]);
+        }
+
+        op_stats[records[i].op].calls++;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    const double total = elapsed_ns(&start, &end);
+
+    printf("%zu calls replayed in %.3f ms (%.1f ns/call), %lu skipped\n",
+           count, total / 1e6, count ? total / (double)count : 0.0, (unsigned long)skipped);
+
+    printf("%-26s %12s", "operation", "calls");
+
+    if (breakdown)
+    {
+        printf(" %12s %12s", "total ms", "ns/call");
+    }
+
+    printf("\n");
+
+    for (int op = 0; op < DS_TRACE_OP_COUNT; ++op)
+    {
+        if (!op_stats[op].calls)
+        {
+            continue;
+        }
+
+        printf("%-26s %12lu", ds_trace_op_name((ds_trace_op)op), (unsigned long)op_stats[op].calls);
+
+        if (breakdown)
+        {
+            printf(" %12.3f %12.1f", op_stats[op].nanoseconds / 1e6,
+                   op_stats[op].nanoseconds / (double)op_stats[op].calls);
+        }
+
+        printf("\n");
+    }
+
+    for (size_t i = 0; i < container_capacity; ++i)
+    {
+        dynarr_snapshot_destroy(containers[i].snapshot);
+        dynarr_destroy(containers[i].array);
+        slist_destroy(containers[i].list);
+    }
+
+    free(containers);
+    free(element);
+    free(records);
+    return EXIT_SUCCESS;
+}
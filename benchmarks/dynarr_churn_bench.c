@@ -0,0 +1,88 @@
+/**************************************************************************
+ *   dynarr_churn_bench.c  --                                             *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+/*
+ * Measures the create / add-few / destroy churn of small dynamic arrays.
+ * Usage: dynarr_churn_bench [iterations]
+ */
+
+#include <time.h>
+
+#include "../lists/dynamic_array.h"
+
+/* The number of elements added to each list before it is destroyed */
+static const size_t element_counts[] = {0, 1, 2, 4, 8, 16, 64};
+
+static double elapsed_ns(const struct timespec* start, const struct timespec* end)
+{
+    return ((double)(end->tv_sec - start->tv_sec) * 1e9) + (double)(end->tv_nsec - start->tv_nsec);
+}
+
+int main(const int argc, char** argv)
+{
+    const size_t iterations = (argc > 1) ? strtoull(argv[1], nullptr, 10) : 1000000;
+
+    if (iterations == 0)
+    {
+        fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("inline capacity: %d elements\n", DYNARR_INLINE_CAPACITY);
+    printf("%10s %14s %14s\n", "elements", "empty ns/op", "sized ns/op");
+
+    /* Keeps the compiler from optimizing the lists away */
+    size_t checksum = 0;
+
+    for (size_t c = 0; c < sizeof(element_counts) / sizeof(element_counts[0]); ++c)
+    {
+        const size_t count = element_counts[c];
+        double results[2];
+
+        for (int sized = 0; sized < 2; ++sized)
+        {
+            struct timespec start, end;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                dynamic_array* list = sized
+                                          ? dynarr_initialize_sized(count, sizeof(int))
+                                          : dynarr_initialize_empty(sizeof(int));
+                if (!list)
+                {
+                    fprintf(stderr, "allocation failed\n");
+                    return EXIT_FAILURE;
+                }
+
+                for (size_t j = 0; j < count; ++j)
+                {
+                    const int value = (int)j;
+                    dynarr_add(list, &value, sizeof(int));
+                }
+
+                checksum += dynarr_size(list);
+                dynarr_destroy(list);
+            }
+
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            results[sized] = elapsed_ns(&start, &end) / (double)iterations;
+        }
+
+        printf("%10zu %14.1f %14.1f\n", count, results[0], results[1]);
+    }
+
+    return checksum == 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,105 @@
+/**************************************************************************
+ *   segarr_growth_bench.c  --                                            *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+/*
+ * Measures the latency of every append while a list grows, comparing dynamic_array,
+ * which copies its buffer on growth, with segmented_array, which never moves elements.
+ * The percentiles include the overhead of reading the clock around every call.
+ * Usage: segarr_growth_bench [elements] [element_size]
+ */
+
+#include <time.h>
+
+#include "../lists/dynamic_array.h"
+#include "../lists/segmented_array.h"
+
+static uint64_t now_ns(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return ((uint64_t)time.tv_sec * 1000000000ULL) + (uint64_t)time.tv_nsec;
+}
+
+static int compare_uint64(const void* a, const void* b)
+{
+    const uint64_t x = *(const uint64_t*)a;
+    const uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void report(const char* name, uint64_t* latencies, const size_t count, const uint64_t total)
+{
+    qsort(latencies, count, sizeof(uint64_t), compare_uint64);
+
+    printf("%-16s %10.1f %10lu %10lu %10lu %10lu %12lu\n", name,
+           (double)total / (double)count,
+           (unsigned long)latencies[count / 2],
+           (unsigned long)latencies[(size_t)((double)count * 0.99)],
+           (unsigned long)latencies[(size_t)((double)count * 0.999)],
+           (unsigned long)latencies[(size_t)((double)count * 0.9999)],
+           (unsigned long)latencies[count - 1]);
+}
+
+int main(const int argc, char** argv)
+{
+    const size_t elements = (argc > 1) ? strtoull(argv[1], nullptr, 10) : ((size_t)1 << 22);
+    const size_t element_size = (argc > 2) ? strtoull(argv[2], nullptr, 10) : sizeof(uint64_t);
+
+    uint64_t* latencies = malloc(elements * sizeof(uint64_t));
+    unsigned char* element = calloc(1, element_size ? element_size : 1);
+
+    if ((elements == 0) || (element_size == 0) || !latencies || !element)
+    {
+        fprintf(stderr, "usage: %s [elements] [element_size]\n", argv[0]);
+        free(latencies);
+        free(element);
+        return EXIT_FAILURE;
+    }
+
+    printf("%zu appends of %zu bytes, latency in ns\n", elements, element_size);
+    printf("%-16s %10s %10s %10s %10s %10s %12s\n", "container", "mean", "p50", "p99", "p99.9", "p99.99", "max");
+
+    dynamic_array* array = dynarr_initialize_empty(element_size);
+    uint64_t start = now_ns();
+
+    for (size_t i = 0; i < elements; ++i)
+    {
+        memcpy(element, &i, element_size < sizeof(i) ? element_size : sizeof(i));
+        const uint64_t before = now_ns();
+        dynarr_add(array, element, element_size);
+        latencies[i] = now_ns() - before;
+    }
+
+    report("dynamic_array", latencies, elements, now_ns() - start);
+    dynarr_destroy(array);
+
+    segmented_array* segmented = segarr_initialize(element_size);
+    start = now_ns();
+
+    for (size_t i = 0; i < elements; ++i)
+    {
+        memcpy(element, &i, element_size < sizeof(i) ? element_size : sizeof(i));
+        const uint64_t before = now_ns();
+        segarr_add(segmented, element, element_size);
+        latencies[i] = now_ns() - before;
+    }
+
+    report("segmented_array", latencies, elements, now_ns() - start);
+    segarr_destroy(segmented);
+
+    free(latencies);
+    free(element);
+    return EXIT_SUCCESS;
+}
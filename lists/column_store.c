@@ -0,0 +1,579 @@
+/**************************************************************************
+ *   column_store.c  --                                                   *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#include "column_store.h"
+
+/* The number of rows compared before the matches are collected */
+#define COLSTORE_MATCH_BLOCK 256
+
+/* Structure type. */
+typedef struct COLUMN_STORE
+{
+    /* The fields of a record, field i is stored in columns[i] */
+    colstore_field* fields;
+    /* One dynamic array per field, each element as wide as its field */
+    dynamic_array** columns;
+    /* The number of fields */
+    size_t field_count;
+    /* The size of a whole record in bytes */
+    size_t row_size;
+    /* The number of rows */
+    size_t rows;
+    /* Room for the widest field, used when values are removed */
+    void* scratch;
+} column_store;
+
+
+static bool colstore_has_field(const column_store* store, const size_t field)
+{
+    return store && (field < store->field_count);
+}
+
+column_store* colstore_initialize(const colstore_field* fields, const size_t field_count, const size_t row_size)
+{
+    if ((!fields) || (field_count == 0) || (row_size == 0))
+    {
+        return nullptr;
+    }
+
+    size_t widest = 0;
+    for (size_t i = 0; i < field_count; ++i)
+    {
+        if ((fields[i].width == 0) || (fields[i].offset > row_size) ||
+            (fields[i].width > row_size - fields[i].offset))
+        {
+            return nullptr;
+        }
+
+        if (fields[i].width > widest)
+        {
+            widest = fields[i].width;
+        }
+    }
+
+    column_store* store = calloc(1, sizeof(column_store));
+
+    if (!store)
+    {
+        return nullptr;
+    }
+
+    store->fields = malloc(field_count * sizeof(colstore_field));
+    store->columns = calloc(field_count, sizeof(dynamic_array*));
+    store->scratch = malloc(widest);
+    store->field_count = field_count;
+    store->row_size = row_size;
+
+    if ((!store->fields) || (!store->columns) || (!store->scratch))
+    {
+        colstore_destroy(store);
+        return nullptr;
+    }
+
+    memcpy(store->fields, fields, field_count * sizeof(colstore_field));
+
+    for (size_t i = 0; i < field_count; ++i)
+    {
+        store->columns[i] = dynarr_initialize_empty(fields[i].width);
+
+        if (!store->columns[i])
+        {
+            colstore_destroy(store);
+            return nullptr;
+        }
+    }
+
+    return store;
+}
+
+void colstore_destroy(column_store* store)
+{
+    if (!store)
+    {
+        return;
+    }
+
+    if (store->columns)
+    {
+        for (size_t i = 0; i < store->field_count; ++i)
+        {
+            dynarr_destroy(store->columns[i]);
+        }
+    }
+
+    free(store->columns);
+    free(store->fields);
+    free(store->scratch);
+    free(store);
+}
+
+bool colstore_add_row(column_store* store, const void* row, const size_t row_size)
+{
+    if ((!store || !row) || (store->row_size != row_size))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < store->field_count; ++i)
+    {
+        const colstore_field* field = &store->fields[i];
+
+        if (!dynarr_add(store->columns[i], (const unsigned char*)row + field->offset, field->width))
+        {
+            /* Drop the values already appended so every column keeps the same length */
+            for (size_t j = 0; j < i; ++j)
+            {
+                dynarr_remove_at(store->columns[j], store->rows, store->scratch, store->fields[j].width);
+            }
+
+            return false;
+        }
+    }
+
+    store->rows++;
+
+    return true;
+}
+
+bool colstore_get_row(const column_store* store, const size_t index, void* out_row, const size_t row_size)
+{
+    if ((!store || !out_row) || (store->row_size != row_size) || (index >= store->rows))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < store->field_count; ++i)
+    {
+        const colstore_field* field = &store->fields[i];
+        dynarr_get(store->columns[i], index, (unsigned char*)out_row + field->offset, field->width);
+    }
+
+    return true;
+}
+
+bool colstore_set_row(column_store* store, const size_t index, const void* row, const size_t row_size)
+{
+    if ((!store || !row) || (store->row_size != row_size) || (index >= store->rows))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < store->field_count; ++i)
+    {
+        const colstore_field* field = &store->fields[i];
+        dynarr_set(store->columns[i], index, (const unsigned char*)row + field->offset, field->width);
+    }
+
+    return true;
+}
+
+bool colstore_remove_row(column_store* store, const size_t index)
+{
+    if ((!store) || (index >= store->rows))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < store->field_count; ++i)
+    {
+        dynarr_remove_at(store->columns[i], index, store->scratch, store->fields[i].width);
+    }
+
+    store->rows--;
+
+    return true;
+}
+
+bool colstore_get_field(const column_store* store, const size_t index, const size_t field, void* out_value)
+{
+    if ((!colstore_has_field(store, field)) || (!out_value))
+    {
+        return false;
+    }
+
+    return dynarr_get(store->columns[field], index, out_value, store->fields[field].width);
+}
+
+bool colstore_set_field(column_store* store, const size_t index, const size_t field, const void* value)
+{
+    if ((!colstore_has_field(store, field)) || (!value))
+    {
+        return false;
+    }
+
+    return dynarr_set(store->columns[field], index, value, store->fields[field].width);
+}
+
+const void* colstore_column(const column_store* store, const size_t field)
+{
+    if (!colstore_has_field(store, field))
+    {
+        return nullptr;
+    }
+
+    return dynarr_data(store->columns[field]);
+}
+
+bool colstore_scan(const column_store* store, const size_t field,
+                   void (*visit)(const void* value, size_t index, void* context), void* context)
+{
+    if ((!colstore_has_field(store, field)) || (!visit))
+    {
+        return false;
+    }
+
+    const unsigned char* values = dynarr_data(store->columns[field]);
+    const size_t width = store->fields[field].width;
+
+    for (size_t i = 0; i < store->rows; ++i)
+    {
+        visit(values + (i * width), i, context);
+    }
+
+    return true;
+}
+
+bool colstore_filter(const column_store* store, const size_t field,
+                     bool (*predicate)(const void* value, void* context), void* context, dynamic_array* out_rows)
+{
+    if ((!colstore_has_field(store, field)) || (!predicate) || (!out_rows))
+    {
+        return false;
+    }
+
+    const unsigned char* values = dynarr_data(store->columns[field]);
+    const size_t width = store->fields[field].width;
+
+    for (size_t i = 0; i < store->rows; ++i)
+    {
+        if (predicate(values + (i * width), context) && (!dynarr_add(out_rows, &i, sizeof(size_t))))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Each helper writes a 0/1 flag per value and returns whether any value matched.
+ * The loops have no branches and no early exit, so they vectorize; the values are
+ * loaded with memcpy because the column may hold any type of that width.
+ */
+static bool colstore_match_8(const unsigned char* values, const size_t count, const void* key, unsigned char* flags)
+{
+    uint8_t k;
+    memcpy(&k, key, sizeof(k));
+    unsigned char any = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        flags[i] = (values[i] == k);
+        any |= flags[i];
+    }
+
+    return any;
+}
+
+static bool colstore_match_16(const unsigned char* values, const size_t count, const void* key, unsigned char* flags)
+{
+    uint16_t k;
+    memcpy(&k, key, sizeof(k));
+    unsigned char any = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint16_t v;
+        memcpy(&v, values + (i * sizeof(v)), sizeof(v));
+        flags[i] = (v == k);
+        any |= flags[i];
+    }
+
+    return any;
+}
+
+static bool colstore_match_32(const unsigned char* values, const size_t count, const void* key, unsigned char* flags)
+{
+    uint32_t k;
+    memcpy(&k, key, sizeof(k));
+    unsigned char any = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t v;
+        memcpy(&v, values + (i * sizeof(v)), sizeof(v));
+        flags[i] = (v == k);
+        any |= flags[i];
+    }
+
+    return any;
+}
+
+static bool colstore_match_64(const unsigned char* values, const size_t count, const void* key, unsigned char* flags)
+{
+    uint64_t k;
+    memcpy(&k, key, sizeof(k));
+    unsigned char any = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint64_t v;
+        memcpy(&v, values + (i * sizeof(v)), sizeof(v));
+        flags[i] = (v == k);
+        any |= flags[i];
+    }
+
+    return any;
+}
+
+static bool colstore_match_bytes(const unsigned char* values, const size_t count, const size_t width,
+                                 const void* key, unsigned char* flags)
+{
+    unsigned char any = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        flags[i] = !memcmp(values + (i * width), key, width);
+        any |= flags[i];
+    }
+
+    return any;
+}
+
+bool colstore_filter_equal(const column_store* store, const size_t field, const void* value, dynamic_array* out_rows)
+{
+    if ((!colstore_has_field(store, field)) || (!value) || (!out_rows))
+    {
+        return false;
+    }
+
+    const unsigned char* values = dynarr_data(store->columns[field]);
+    const size_t width = store->fields[field].width;
+    unsigned char flags[COLSTORE_MATCH_BLOCK];
+
+    for (size_t start = 0; start < store->rows; start += COLSTORE_MATCH_BLOCK)
+    {
+        const size_t remaining = store->rows - start;
+        const size_t count = (remaining < COLSTORE_MATCH_BLOCK) ? remaining : COLSTORE_MATCH_BLOCK;
+        const unsigned char* block = values + (start * width);
+
+        bool any;
+        switch (width)
+        {
+        case 1:
+            any = colstore_match_8(block, count, value, flags);
+            break;
+        case 2:
+            any = colstore_match_16(block, count, value, flags);
+            break;
+        case 4:
+            any = colstore_match_32(block, count, value, flags);
+            break;
+        case 8:
+            any = colstore_match_64(block, count, value, flags);
+            break;
+        default:
+            any = colstore_match_bytes(block, count, width, value, flags);
+            break;
+        }
+
+        /* Most blocks of a selective filter have no match and are skipped here */
+        if (!any)
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const size_t row = start + i;
+
+            if (flags[i] && (!dynarr_add(out_rows, &row, sizeof(size_t))))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/* The column a sort orders the rows by, passed to every comparison */
+typedef struct colstore_sort_key
+{
+    /* The values of the column */
+    const unsigned char* values;
+    /* The width of a value in bytes */
+    size_t width;
+    /* The comparison function of the caller */
+    int (*compar)(const void*, const void*);
+} colstore_sort_key;
+
+static int colstore_compare_rows(const colstore_sort_key* key, const size_t left, const size_t right)
+{
+    return key->compar(key->values + (left * key->width), key->values + (right * key->width));
+}
+
+/*
+ * Sorts row indices by their values with a bottom-up merge sort, merging runs of width 1, 2, 4...
+ * back and forth between order and scratch. Ties take the left run first, which keeps the sort stable.
+ * Returns whichever of the two buffers holds the sorted indices.
+ */
+static size_t* colstore_sort_rows(const colstore_sort_key* key, size_t* order, size_t* scratch, const size_t rows)
+{
+    size_t* from = order;
+    size_t* to = scratch;
+
+    for (size_t width = 1; width < rows; width *= 2)
+    {
+        for (size_t start = 0; start < rows; start += 2 * width)
+        {
+            const size_t middle = (rows - start < width) ? rows : start + width;
+            const size_t end = (rows - middle < width) ? rows : middle + width;
+            size_t left = start;
+            size_t right = middle;
+            size_t out = start;
+
+            while ((left < middle) && (right < end))
+            {
+                to[out++] = (colstore_compare_rows(key, from[right], from[left]) < 0) ? from[right++] : from[left++];
+            }
+
+            while (left < middle)
+            {
+                to[out++] = from[left++];
+            }
+
+            while (right < end)
+            {
+                to[out++] = from[right++];
+            }
+        }
+
+        size_t* merged = to;
+        to = from;
+        from = merged;
+    }
+
+    return from;
+}
+
+bool colstore_sort_by(column_store* store, const size_t field, int (*compar)(const void*, const void*))
+{
+    if ((!colstore_has_field(store, field)) || (!compar))
+    {
+        return false;
+    }
+
+    if (store->rows < 2)
+    {
+        return true;
+    }
+
+    size_t* order = malloc(store->rows * sizeof(size_t));
+    size_t* scratch = malloc(store->rows * sizeof(size_t));
+    dynamic_array** sorted = calloc(store->field_count, sizeof(dynamic_array*));
+
+    if ((!order) || (!scratch) || (!sorted))
+    {
+        free(order);
+        free(scratch);
+        free(sorted);
+        return false;
+    }
+
+    for (size_t i = 0; i < store->rows; ++i)
+    {
+        order[i] = i;
+    }
+
+    /* Only the key column is read while sorting */
+    const colstore_sort_key key = {dynarr_data(store->columns[field]), store->fields[field].width, compar};
+    const size_t* rows = colstore_sort_rows(&key, order, scratch, store->rows);
+
+    /* Gather every column in the new order, replacing the columns only once all of them succeeded */
+    bool ok = true;
+    for (size_t i = 0; (i < store->field_count) && ok; ++i)
+    {
+        const size_t width = store->fields[i].width;
+        const unsigned char* values = dynarr_data(store->columns[i]);
+
+        sorted[i] = dynarr_initialize_sized(store->rows, width);
+        ok = (sorted[i] != nullptr);
+
+        for (size_t j = 0; (j < store->rows) && ok; ++j)
+        {
+            ok = dynarr_add(sorted[i], values + (rows[j] * width), width);
+        }
+    }
+
+    for (size_t i = 0; i < store->field_count; ++i)
+    {
+        if (ok)
+        {
+            dynarr_destroy(store->columns[i]);
+            store->columns[i] = sorted[i];
+        }
+        else
+        {
+            dynarr_destroy(sorted[i]);
+        }
+    }
+
+    free(sorted);
+    free(scratch);
+    free(order);
+
+    return ok;
+}
+
+void colstore_clear(column_store* store)
+{
+    if (!store)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < store->field_count; ++i)
+    {
+        dynarr_clear(store->columns[i]);
+    }
+
+    store->rows = 0;
+}
+
+size_t colstore_rows(const column_store* store)
+{
+    if (!store)
+    {
+        return 0;
+    }
+
+    return store->rows;
+}
+
+size_t colstore_field_count(const column_store* store)
+{
+    if (!store)
+    {
+        return 0;
+    }
+
+    return store->field_count;
+}
+
+bool colstore_is_empty(const column_store* store)
+{
+    if (!store)
+    {
+        return true;
+    }
+
+    return store->rows == 0;
+}
@@ -0,0 +1,139 @@
+/**************************************************************************
+ *   column_store.h  --                                                   *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#ifndef _DATASTRUCTURES_COLUMN_STORE_H
+#define _DATASTRUCTURES_COLUMN_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "dynamic_array.h"
+
+/*
+ * A table of records stored as one dynamic array per field (struct of arrays).
+ * Rows are added and read back as whole records laid out as described by the schema,
+ * while scans, filters and sorts read a single contiguous column and touch only its bytes.
+ */
+
+/* A field of a record, at @offset bytes from its start and @width bytes wide */
+typedef struct colstore_field
+{
+    size_t offset;
+    size_t width;
+} colstore_field;
+
+/* Describes the field @member of the record type @type */
+#define COLSTORE_FIELD(type, member) \
+    ((colstore_field){offsetof(type, member), sizeof(((type*)nullptr)->member)})
+
+/* Structure type. */
+typedef struct COLUMN_STORE column_store;
+
+/**
+ * Initializes an empty column store.
+ * @param fields The fields of a record, each stored in its own column.
+ * @param field_count The number of fields.
+ * @param row_size The size of a whole record (in bytes), every field must lie inside it.
+ * @returns a pointer to the column store initialized, or nullptr if the schema is invalid. */
+column_store* colstore_initialize(const colstore_field* fields, const size_t field_count, const size_t row_size);
+
+/**
+ * Destroys a column store and frees the allocated memory.
+ * @param store The column store to be destroyed. */
+void colstore_destroy(column_store* store);
+
+
+/**
+ * Appends a record, splitting its fields into their columns.
+ * @param store The column store.
+ * @param row The record to add.
+ * @param row_size The size of the record (in bytes).
+ * @returns true if the record was added, false otherwise. */
+bool colstore_add_row(column_store* store, const void* row, const size_t row_size);
+
+/**
+ * Gathers the fields of a record. Bytes of @out_row outside every field are left untouched.
+ * @param store The column store.
+ * @param index The index of the row.
+ * @param out_row Receives the record.
+ * @param row_size The size of the record (in bytes).
+ * @returns true if the row exists, false otherwise. */
+bool colstore_get_row(const column_store* store, const size_t index, void* out_row, const size_t row_size);
+bool colstore_set_row(column_store* store, const size_t index, const void* row, const size_t row_size);
+bool colstore_remove_row(column_store* store, const size_t index);
+
+
+bool colstore_get_field(const column_store* store, const size_t index, const size_t field, void* out_value);
+bool colstore_set_field(column_store* store, const size_t index, const size_t field, const void* value);
+
+/**
+ * Returns a column as a contiguous read-only buffer of colstore_rows() values.
+ * The pointer is invalidated by any call that modifies the store.
+ * @param store The column store.
+ * @param field The index of the field.
+ * @returns a pointer to the first value, or nullptr if the field does not exist. */
+const void* colstore_column(const column_store* store, const size_t field);
+
+
+/**
+ * Calls @visit on every value of a column, in row order.
+ * @param store The column store.
+ * @param field The index of the field.
+ * @param visit Receives a value, its row and @context.
+ * @param context Passed to @visit.
+ * @returns true if the field exists, false otherwise. */
+bool colstore_scan(const column_store* store, const size_t field,
+                   void (*visit)(const void* value, size_t index, void* context), void* context);
+
+/**
+ * Appends the indices of the rows whose value matches a predicate.
+ * @param store The column store.
+ * @param field The index of the field.
+ * @param predicate Returns true for the values to select.
+ * @param context Passed to @predicate.
+ * @param out_rows A dynamic array of size_t receiving the row indices in ascending order.
+ * @returns true on success, false if the field does not exist or @out_rows could not grow. */
+bool colstore_filter(const column_store* store, const size_t field,
+                     bool (*predicate)(const void* value, void* context), void* context, dynamic_array* out_rows);
+
+/**
+ * Appends the indices of the rows whose value is bytewise equal to @value.
+ * Columns 1, 2, 4 or 8 bytes wide are compared with branch-free loops the compiler can vectorize.
+ * @param store The column store.
+ * @param field The index of the field.
+ * @param value The value to look for, as wide as the field.
+ * @param out_rows A dynamic array of size_t receiving the row indices in ascending order.
+ * @returns true on success, false if the field does not exist or @out_rows could not grow. */
+bool colstore_filter_equal(const column_store* store, const size_t field, const void* value, dynamic_array* out_rows);
+
+/**
+ * Sorts the rows by the values of one column. The sort is stable.
+ * The order is computed on that column alone and then applied to every column.
+ * @param store The column store.
+ * @param field The index of the field to sort by.
+ * @param compar The comparison function, as for qsort(), called on two values of the field.
+ * @returns true if the rows were sorted, false if the field does not exist or memory ran out. */
+bool colstore_sort_by(column_store* store, const size_t field, int (*compar)(const void*, const void*));
+
+
+void colstore_clear(column_store* store);
+size_t colstore_rows(const column_store* store);
+size_t colstore_field_count(const column_store* store);
+bool colstore_is_empty(const column_store* store);
+
+#endif //_DATASTRUCTURES_COLUMN_STORE_H
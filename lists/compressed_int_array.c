@@ -0,0 +1,680 @@
+/**************************************************************************
+ *   compressed_int_array.c  --                                           *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#include "compressed_int_array.h"
+
+static_assert((CINTARR_BLOCK_SIZE > 0) && (CINTARR_BLOCK_SIZE % 64 == 0),
+              "CINTARR_BLOCK_SIZE must be a multiple of 64");
+
+static_assert((CINTARR_DELTA_ANCHOR_INTERVAL > 0) && (CINTARR_BLOCK_SIZE % CINTARR_DELTA_ANCHOR_INTERVAL == 0),
+              "CINTARR_DELTA_ANCHOR_INTERVAL must divide CINTARR_BLOCK_SIZE");
+
+/* A block of b bits per value fills exactly this many words */
+#define CINTARR_BLOCK_WORDS(bits) ((size_t)(bits) * (CINTARR_BLOCK_SIZE / 64))
+
+/* The whole values stored after the packed words of a delta block, the first one being in the header */
+#define CINTARR_DELTA_ANCHORS ((CINTARR_BLOCK_SIZE / CINTARR_DELTA_ANCHOR_INTERVAL) - 1)
+
+/* How the packed values of a block are turned back into values */
+typedef enum cintarr_mode
+{
+    /* value[i] = base + packed[i] */
+    CINTARR_FRAME_OF_REFERENCE,
+    /* value[0] = first, value[i] = value[i - 1] + base + packed[i],
+     * value[k * CINTARR_DELTA_ANCHOR_INTERVAL] = anchor[k - 1] */
+    CINTARR_DELTA
+} cintarr_mode;
+
+/* The header of a compressed block */
+typedef struct cintarr_block
+{
+    /* The first value of the block, searched by binary search */
+    uint64_t first;
+    /* The minimum value, or the smallest gap in delta mode */
+    uint64_t base;
+    /* The index of the block's first word */
+    size_t offset;
+    /* The number of bits per packed value, from 0 to 64 */
+    uint8_t bits;
+    uint8_t mode;
+} cintarr_block;
+
+/* Structure type. */
+typedef struct COMPRESSED_INT_ARRAY
+{
+    /* The packed values of every block, one after the other */
+    uint64_t* words;
+    size_t word_count;
+    size_t word_capacity;
+    /* The headers of the compressed blocks */
+    cintarr_block* blocks;
+    size_t block_count;
+    size_t block_capacity;
+    /* The values past the last compressed block */
+    uint64_t tail[CINTARR_BLOCK_SIZE];
+    size_t tail_count;
+    /* The last value added, to keep track of sortedness */
+    uint64_t last;
+    bool sorted;
+#ifdef DS_STATS
+    /* The operation counters of the list */
+    ds_atomic_stats stats;
+#endif
+} compressed_int_array;
+
+
+static unsigned bits_needed(const uint64_t value)
+{
+    if (value == 0)
+    {
+        return 0;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    return 64 - (unsigned)__builtin_clzll(value);
+#else
+    unsigned res = 0;
+    uint64_t rest = value;
+    while (rest)
+    {
+        res++;
+        rest >>= 1;
+    }
+    return res;
+#endif
+}
+
+static uint64_t bits_mask(const unsigned bits)
+{
+    return (bits == 64) ? UINT64_MAX : (((uint64_t)1 << bits) - 1);
+}
+
+/* Reads the packed value at position i of a block */
+static uint64_t cintarr_extract(const uint64_t* words, const unsigned bits, const size_t i)
+{
+    if (bits == 0)
+    {
+        return 0;
+    }
+
+    const size_t bit = i * bits;
+    const size_t word = bit / 64;
+    const unsigned shift = bit % 64;
+
+    uint64_t value = words[word] >> shift;
+    if (shift + bits > 64)
+    {
+        value |= words[word + 1] << (64 - shift);
+    }
+
+    return value & bits_mask(bits);
+}
+
+/*
+ * Unpacks a whole block. Widths dividing 64 never straddle two words, so their
+ * loop is branch-free and vectorizes; the other widths take the general path.
+ */
+static void cintarr_unpack(const uint64_t* words, const unsigned bits, uint64_t* out)
+{
+    if (bits == 0)
+    {
+        memset(out, 0, CINTARR_BLOCK_SIZE * sizeof(uint64_t));
+        return;
+    }
+
+    const uint64_t mask = bits_mask(bits);
+
+    if (64 % bits == 0)
+    {
+        const unsigned per_word = 64 / bits;
+        for (size_t i = 0; i < CINTARR_BLOCK_SIZE; ++i)
+        {
+            out[i] = (words[i / per_word] >> ((i % per_word) * bits)) & mask;
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < CINTARR_BLOCK_SIZE; ++i)
+    {
+        out[i] = cintarr_extract(words, bits, i);
+    }
+}
+
+static void cintarr_pack(const uint64_t* values, const unsigned bits, uint64_t* words)
+{
+    /* A block of zero-width values has no words, which may not even be allocated yet */
+    if (bits == 0)
+    {
+        return;
+    }
+
+    memset(words, 0, CINTARR_BLOCK_WORDS(bits) * sizeof(uint64_t));
+
+    for (size_t i = 0; i < CINTARR_BLOCK_SIZE; ++i)
+    {
+        const size_t bit = i * bits;
+        const size_t word = bit / 64;
+        const unsigned shift = bit % 64;
+
+        words[word] |= values[i] << shift;
+        if (shift + bits > 64)
+        {
+            words[word + 1] |= values[i] >> (64 - shift);
+        }
+    }
+}
+
+/* Turns the packed values of a block back into values */
+static void cintarr_decode_block(const compressed_int_array* list, const size_t block, uint64_t* out)
+{
+    if (block == list->block_count)
+    {
+        memcpy(out, list->tail, list->tail_count * sizeof(uint64_t));
+        return;
+    }
+
+    const cintarr_block* header = &list->blocks[block];
+    cintarr_unpack(list->words + header->offset, header->bits, out);
+
+    if (header->mode == CINTARR_FRAME_OF_REFERENCE)
+    {
+        for (size_t i = 0; i < CINTARR_BLOCK_SIZE; ++i)
+        {
+            out[i] += header->base;
+        }
+    }
+    else
+    {
+        out[0] = header->first;
+        for (size_t i = 1; i < CINTARR_BLOCK_SIZE; ++i)
+        {
+            out[i] += out[i - 1] + header->base;
+        }
+    }
+}
+
+static bool cintarr_reserve(compressed_int_array* list, const size_t words)
+{
+    if (list->block_count == list->block_capacity)
+    {
+        const size_t capacity = list->block_capacity ? list->block_capacity * 2 : 4;
+        cintarr_block* blocks = realloc(list->blocks, capacity * sizeof(cintarr_block));
+        if (!blocks)
+        {
+            return false;
+        }
+        DS_STATS_COUNT(list, reallocations, 1);
+        list->blocks = blocks;
+        list->block_capacity = capacity;
+    }
+
+    if (list->word_count + words > list->word_capacity)
+    {
+        size_t capacity = list->word_capacity ? list->word_capacity * 2 : CINTARR_BLOCK_WORDS(64);
+        while (capacity < list->word_count + words)
+        {
+            capacity *= 2;
+        }
+        uint64_t* data = realloc(list->words, capacity * sizeof(uint64_t));
+        if (!data)
+        {
+            return false;
+        }
+        DS_STATS_COUNT(list, reallocations, 1);
+        list->words = data;
+        list->word_capacity = capacity;
+    }
+
+    return true;
+}
+
+/* Compresses the full tail into a new block, choosing the encoding with the fewest bits */
+static bool cintarr_flush_tail(compressed_int_array* list)
+{
+    const uint64_t* values = list->tail;
+
+    uint64_t min = values[0];
+    uint64_t max = values[0];
+    uint64_t min_gap = UINT64_MAX;
+    uint64_t max_gap = 0;
+    bool ascending = true;
+
+    for (size_t i = 1; i < CINTARR_BLOCK_SIZE; ++i)
+    {
+        min = (values[i] < min) ? values[i] : min;
+        max = (values[i] > max) ? values[i] : max;
+        if (values[i] < values[i - 1])
+        {
+            ascending = false;
+        }
+        else
+        {
+            const uint64_t gap = values[i] - values[i - 1];
+            min_gap = (gap < min_gap) ? gap : min_gap;
+            max_gap = (gap > max_gap) ? gap : max_gap;
+        }
+    }
+
+    cintarr_block header = {.first = values[0], .offset = list->word_count};
+    const unsigned reference_bits = bits_needed(max - min);
+    const unsigned delta_bits = ascending ? bits_needed(max_gap - min_gap) : 64;
+
+    /* The anchors count against delta mode, which is only kept if the block still takes fewer words */
+    uint64_t packed[CINTARR_BLOCK_SIZE];
+    if (ascending && (CINTARR_BLOCK_WORDS(delta_bits) + CINTARR_DELTA_ANCHORS < CINTARR_BLOCK_WORDS(reference_bits)))
+    {
+        header.mode = CINTARR_DELTA;
+        header.base = min_gap;
+        header.bits = (uint8_t)delta_bits;
+        packed[0] = 0;
+        for (size_t i = 1; i < CINTARR_BLOCK_SIZE; ++i)
+        {
+            packed[i] = values[i] - values[i - 1] - min_gap;
+        }
+    }
+    else
+    {
+        header.mode = CINTARR_FRAME_OF_REFERENCE;
+        header.base = min;
+        header.bits = (uint8_t)reference_bits;
+        for (size_t i = 0; i < CINTARR_BLOCK_SIZE; ++i)
+        {
+            packed[i] = values[i] - min;
+        }
+    }
+
+    const size_t anchors = (header.mode == CINTARR_DELTA) ? CINTARR_DELTA_ANCHORS : 0;
+    if (!cintarr_reserve(list, CINTARR_BLOCK_WORDS(header.bits) + anchors))
+    {
+        return false;
+    }
+
+    uint64_t* words = list->words + list->word_count;
+    cintarr_pack(packed, header.bits, words);
+    for (size_t i = 0; i < anchors; ++i)
+    {
+        words[CINTARR_BLOCK_WORDS(header.bits) + i] = values[(i + 1) * CINTARR_DELTA_ANCHOR_INTERVAL];
+    }
+
+    list->word_count += CINTARR_BLOCK_WORDS(header.bits) + anchors;
+    list->blocks[list->block_count++] = header;
+    list->tail_count = 0;
+    DS_STATS_PEAK(list, list->block_count * CINTARR_BLOCK_SIZE);
+
+    return true;
+}
+
+compressed_int_array* cintarr_initialize(void)
+{
+    compressed_int_array* list = calloc(1, sizeof(compressed_int_array));
+
+    if (!list)
+    {
+        return nullptr;
+    }
+
+    list->sorted = true;
+    DS_STATS_COUNT(list, allocations, 1);
+    return list;
+}
+
+compressed_int_array* cintarr_initialize_from(const dynamic_array* list)
+{
+    if ((!list) || (dynarr_data_size(list) != sizeof(uint64_t)))
+    {
+        return nullptr;
+    }
+
+    compressed_int_array* res = cintarr_initialize();
+
+    if (!res)
+    {
+        return nullptr;
+    }
+
+    const size_t size = dynarr_size(list);
+    for (size_t i = 0; i < size; ++i)
+    {
+        uint64_t value;
+        if ((!dynarr_get(list, i, &value, sizeof(uint64_t))) || (!cintarr_add(res, value)))
+        {
+            cintarr_destroy(res);
+            return nullptr;
+        }
+    }
+
+    return res;
+}
+
+void cintarr_destroy(compressed_int_array* list)
+{
+    if (!list)
+    {
+        return;
+    }
+
+    free(list->words);
+    free(list->blocks);
+    free(list);
+}
+
+dynamic_array* cintarr_to_dynarr(const compressed_int_array* list)
+{
+    if (!list)
+    {
+        return nullptr;
+    }
+
+    dynamic_array* res = dynarr_initialize_sized(cintarr_size(list), sizeof(uint64_t));
+
+    if (!res)
+    {
+        return nullptr;
+    }
+
+    cintarr_iterator iterator;
+    cintarr_iterator_init(list, 0, &iterator);
+
+    uint64_t value;
+    while (cintarr_iterator_next(&iterator, &value))
+    {
+        if (!dynarr_add(res, &value, sizeof(uint64_t)))
+        {
+            dynarr_destroy(res);
+            return nullptr;
+        }
+    }
+
+    return res;
+}
+
+bool cintarr_add(compressed_int_array* list, const uint64_t value)
+{
+    if (!list)
+    {
+        return false;
+    }
+
+    /* A tail left full by a failed compression is retried before growing further */
+    if ((list->tail_count == CINTARR_BLOCK_SIZE) && (!cintarr_flush_tail(list)))
+    {
+        return false;
+    }
+
+    if ((!cintarr_is_empty(list)) && (value < list->last))
+    {
+        list->sorted = false;
+    }
+
+    list->tail[list->tail_count++] = value;
+    list->last = value;
+    DS_STATS_COUNT(list, bytes_copied, sizeof(uint64_t));
+
+    if (list->tail_count == CINTARR_BLOCK_SIZE)
+    {
+        cintarr_flush_tail(list);
+    }
+
+    return true;
+}
+
+bool cintarr_get(const compressed_int_array* list, const size_t index, uint64_t* out_value)
+{
+    if ((!list || !out_value) || (index >= cintarr_size(list)))
+    {
+        return false;
+    }
+
+    const size_t block = index / CINTARR_BLOCK_SIZE;
+    const size_t position = index % CINTARR_BLOCK_SIZE;
+
+    if (block == list->block_count)
+    {
+        *out_value = list->tail[position];
+        return true;
+    }
+
+    const cintarr_block* header = &list->blocks[block];
+    const uint64_t* words = list->words + header->offset;
+
+    if (header->mode == CINTARR_FRAME_OF_REFERENCE)
+    {
+        *out_value = header->base + cintarr_extract(words, header->bits, position);
+        return true;
+    }
+
+    /* Starts from the last anchor at or before the value */
+    const size_t anchor = position / CINTARR_DELTA_ANCHOR_INTERVAL;
+    uint64_t value = anchor ? words[CINTARR_BLOCK_WORDS(header->bits) + anchor - 1] : header->first;
+    for (size_t i = (anchor * CINTARR_DELTA_ANCHOR_INTERVAL) + 1; i <= position; ++i)
+    {
+        value += header->base + cintarr_extract(words, header->bits, i);
+    }
+
+    *out_value = value;
+    return true;
+}
+
+void cintarr_iterator_init(const compressed_int_array* list, const size_t index, cintarr_iterator* iterator)
+{
+    if (!iterator)
+    {
+        return;
+    }
+
+    iterator->list = list;
+    iterator->index = index;
+    iterator->block = SIZE_MAX;
+}
+
+bool cintarr_iterator_next(cintarr_iterator* iterator, uint64_t* out_value)
+{
+    if ((!iterator || !out_value) || (iterator->index >= cintarr_size(iterator->list)))
+    {
+        return false;
+    }
+
+    const size_t block = iterator->index / CINTARR_BLOCK_SIZE;
+
+    /* The tail may have grown since it was copied, so it is copied again on every read */
+    if ((block != iterator->block) || (block == iterator->list->block_count))
+    {
+        cintarr_decode_block(iterator->list, block, iterator->values);
+        iterator->block = block;
+    }
+
+    *out_value = iterator->values[iterator->index % CINTARR_BLOCK_SIZE];
+    iterator->index++;
+
+    return true;
+}
+
+bool cintarr_is_sorted(const compressed_int_array* list)
+{
+    if (!list)
+    {
+        return false;
+    }
+
+    return list->sorted;
+}
+
+/* The first value of a block, the tail counting as the last block */
+static uint64_t cintarr_block_first(const compressed_int_array* list, const size_t block)
+{
+    return (block == list->block_count) ? list->tail[0] : list->blocks[block].first;
+}
+
+bool cintarr_binary_search(const compressed_int_array* list, const uint64_t value, size_t* index)
+{
+    if ((!list || !index) || (!list->sorted))
+    {
+        return false;
+    }
+
+    const size_t size = cintarr_size(list);
+
+    /* Counts the blocks starting below the value, the first occurrence is in the last of them or right after it */
+    size_t low = 0;
+    size_t high = list->block_count + (list->tail_count > 0);
+    while (low < high)
+    {
+        const size_t middle = low + ((high - low) / 2);
+        if (cintarr_block_first(list, middle) < value)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+        DS_STATS_COUNT(list, comparisons, 1);
+    }
+
+    size_t position = low * CINTARR_BLOCK_SIZE;
+
+    if (low > 0)
+    {
+        const size_t block = low - 1;
+        const size_t count = (block == list->block_count) ? list->tail_count : CINTARR_BLOCK_SIZE;
+        uint64_t values[CINTARR_BLOCK_SIZE];
+        cintarr_decode_block(list, block, values);
+
+        size_t first = 0;
+        size_t last = count;
+        while (first < last)
+        {
+            const size_t middle = first + ((last - first) / 2);
+            if (values[middle] < value)
+            {
+                first = middle + 1;
+            }
+            else
+            {
+                last = middle;
+            }
+            DS_STATS_COUNT(list, comparisons, 1);
+        }
+
+        position = (block * CINTARR_BLOCK_SIZE) + first;
+    }
+
+    *index = (position < size) ? position : size;
+
+    uint64_t found;
+    return cintarr_get(list, *index, &found) && (found == value);
+}
+
+void cintarr_clear(compressed_int_array* list)
+{
+    if (!list)
+    {
+        return;
+    }
+
+    list->word_count = 0;
+    list->block_count = 0;
+    list->tail_count = 0;
+    list->sorted = true;
+}
+
+size_t cintarr_size(const compressed_int_array* list)
+{
+    if (!list)
+    {
+        return 0;
+    }
+
+    return (list->block_count * CINTARR_BLOCK_SIZE) + list->tail_count;
+}
+
+bool cintarr_is_empty(const compressed_int_array* list)
+{
+    return cintarr_size(list) == 0;
+}
+
+void cintarr_trim_to_size(compressed_int_array* list)
+{
+    if (!list)
+    {
+        return;
+    }
+
+    if (list->block_count == 0)
+    {
+        free(list->words);
+        free(list->blocks);
+        list->words = nullptr;
+        list->blocks = nullptr;
+        list->word_capacity = 0;
+        list->block_capacity = 0;
+        return;
+    }
+
+    /* A failed shrink keeps the larger buffer, which is still valid */
+    if (list->word_count < list->word_capacity)
+    {
+        uint64_t* words = realloc(list->words, (list->word_count ? list->word_count : 1) * sizeof(uint64_t));
+        if (words)
+        {
+            list->words = words;
+            list->word_capacity = list->word_count;
+            DS_STATS_COUNT(list, reallocations, 1);
+        }
+    }
+
+    if (list->block_count < list->block_capacity)
+    {
+        cintarr_block* blocks = realloc(list->blocks, list->block_count * sizeof(cintarr_block));
+        if (blocks)
+        {
+            list->blocks = blocks;
+            list->block_capacity = list->block_count;
+            DS_STATS_COUNT(list, reallocations, 1);
+        }
+    }
+}
+
+size_t cintarr_memory_usage(const compressed_int_array* list)
+{
+    if (!list)
+    {
+        return 0;
+    }
+
+    return sizeof(compressed_int_array) + (list->word_capacity * sizeof(uint64_t)) +
+        (list->block_capacity * sizeof(cintarr_block));
+}
+
+bool cintarr_get_stats(const compressed_int_array* list, ds_stats* out_stats)
+{
+    if (!out_stats)
+    {
+        return false;
+    }
+
+#ifdef DS_STATS
+    if (!list)
+    {
+        return false;
+    }
+
+    ds_stats_load(&list->stats, out_stats);
+    return true;
+#else
+    (void)list;
+    memset(out_stats, 0, sizeof(ds_stats));
+    return false;
+#endif
+}
@@ -0,0 +1,150 @@
+/**************************************************************************
+ *   compressed_int_array.h  --                                           *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#ifndef _DATASTRUCTURES_COMPRESSED_INT_ARRAY_H
+#define _DATASTRUCTURES_COMPRESSED_INT_ARRAY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "dynamic_array.h"
+#include "ds_stats.h"
+
+/*
+ * An append-only array of 64-bit unsigned integers, compressed in fixed-size blocks.
+ * Each full block is bit-packed either as offsets from its minimum (frame of reference)
+ * or, when its values never decrease, as the gaps between consecutive values minus the smallest gap.
+ * The encoding taking fewer words is kept, and the last partial block stays uncompressed.
+ * Delta blocks also keep every CINTARR_DELTA_ANCHOR_INTERVAL-th value whole, so reads start from the nearest one.
+ */
+
+/* The number of values in a block, a multiple of 64 */
+#ifndef CINTARR_BLOCK_SIZE
+#define CINTARR_BLOCK_SIZE 128
+#endif
+
+/* The distance between the values kept whole in a delta block, dividing CINTARR_BLOCK_SIZE */
+#ifndef CINTARR_DELTA_ANCHOR_INTERVAL
+#define CINTARR_DELTA_ANCHOR_INTERVAL 32
+#endif
+
+/* Structure type. */
+typedef struct COMPRESSED_INT_ARRAY compressed_int_array;
+
+/* Reads the values in order, decoding one block at a time */
+typedef struct cintarr_iterator
+{
+    const compressed_int_array* list;
+    /* The index of the next value */
+    size_t index;
+    /* The block held in values, SIZE_MAX before the first one is decoded */
+    size_t block;
+    uint64_t values[CINTARR_BLOCK_SIZE];
+} cintarr_iterator;
+
+/**
+ * Initializes an empty compressed integer array.
+ * @returns a pointer to the compressed integer array initialized. */
+compressed_int_array* cintarr_initialize(void);
+
+/**
+ * Initializes a compressed integer array holding the elements of a dynamic array of uint64_t.
+ * @param list The dynamic array to compress, its data size must be sizeof(uint64_t).
+ * @returns a pointer to the compressed integer array initialized, or nullptr on failure
+ * or if @list holds elements of another size, even when it is empty. */
+compressed_int_array* cintarr_initialize_from(const dynamic_array* list);
+
+/**
+ * Destroys a compressed integer array and frees the allocated memory.
+ * @param list The compressed integer array to be destroyed. */
+void cintarr_destroy(compressed_int_array* list);
+
+/**
+ * Decompresses the values into a new dynamic array of uint64_t.
+ * @param list The compressed integer array.
+ * @returns a pointer to the dynamic array, or nullptr on failure. */
+dynamic_array* cintarr_to_dynarr(const compressed_int_array* list);
+
+
+bool cintarr_add(compressed_int_array* list, const uint64_t value);
+
+/**
+ * Reads a value. Frame-of-reference blocks are read directly, delta blocks sum up to
+ * CINTARR_DELTA_ANCHOR_INTERVAL - 1 gaps from the nearest anchor, so sequential reads should use an iterator.
+ * @param list The compressed integer array.
+ * @param index The index of the value.
+ * @param out_value Receives the value.
+ * @returns true if the index is in bounds, false otherwise. */
+bool cintarr_get(const compressed_int_array* list, const size_t index, uint64_t* out_value);
+
+
+/**
+ * Positions an iterator on a value.
+ * @param list The compressed integer array.
+ * @param index The index of the first value to read.
+ * @param iterator The iterator to initialize. */
+void cintarr_iterator_init(const compressed_int_array* list, const size_t index, cintarr_iterator* iterator);
+
+/**
+ * Reads the next value of an iterator.
+ * @param iterator The iterator.
+ * @param out_value Receives the value.
+ * @returns true if a value was read, false at the end of the array. */
+bool cintarr_iterator_next(cintarr_iterator* iterator, uint64_t* out_value);
+
+
+/**
+ * Tells whether the values never decrease, which binary search requires.
+ * @param list The compressed integer array.
+ * @returns true if the values are sorted in ascending order. */
+bool cintarr_is_sorted(const compressed_int_array* list);
+
+/**
+ * Finds the first occurrence of a value in a sorted array.
+ * The blocks are searched by their first value, then a single block is decoded.
+ * @param list The compressed integer array.
+ * @param value The value to look for.
+ * @param index Receives the index of the first value not less than @value.
+ * @returns true if @value was found, false if it is absent or the array is not sorted. */
+bool cintarr_binary_search(const compressed_int_array* list, const uint64_t value, size_t* index);
+
+
+void cintarr_clear(compressed_int_array* list);
+size_t cintarr_size(const compressed_int_array* list);
+bool cintarr_is_empty(const compressed_int_array* list);
+
+/**
+ * Frees the unused capacity of the compressed blocks and their headers.
+ * @param list The compressed integer array. */
+void cintarr_trim_to_size(compressed_int_array* list);
+
+/**
+ * Returns the memory held by the compressed blocks, their headers and the uncompressed tail.
+ * @param list The compressed integer array.
+ * @returns the size in bytes. */
+size_t cintarr_memory_usage(const compressed_int_array* list);
+
+
+/**
+ * Reads the operation counters of a compressed integer array.
+ * @param list The compressed integer array.
+ * @param out_stats Receives the counters, zeroed when statistics are disabled.
+ * @returns true if the library was built with DS_STATS. */
+bool cintarr_get_stats(const compressed_int_array* list, ds_stats* out_stats);
+
+#endif //_DATASTRUCTURES_COMPRESSED_INT_ARRAY_H
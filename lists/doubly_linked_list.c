@@ -0,0 +1,897 @@
+/**************************************************************************
+ *   doubly_linked_list.c  --                                             *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#include "doubly_linked_list.h"
+#include "ds_stats.h"
+
+
+/* Doubly linked node */
+typedef struct d_node
+{
+    /* The data stored in the node */
+    void* data;
+    /* The pointer to the next node */
+    d_node* next;
+    /* The pointer to the previous node */
+    d_node* prev;
+} d_node;
+
+/* Doubly linked list */
+typedef struct doubly_linked_list
+{
+    /* The first element of the list */
+    d_node* head;
+    /* The last element of the list */
+    d_node* tail;
+    /* The number of elements in the list */
+    size_t size;
+    /* The size of a single data element in bytes */
+    size_t data_size;
+#ifdef DS_STATS
+    /* The operation counters of the list */
+    ds_atomic_stats stats;
+#endif
+} doubly_linked_list;
+
+/* Local functions */
+static d_node* d_node_initialize(const void* data, const size_t data_size);
+static bool d_node_destroy(d_node* node);
+static d_node* d_node_get_kth(const doubly_linked_list* list, const size_t k);
+static void d_node_link_before(doubly_linked_list* list, d_node* next, d_node* node);
+static void d_node_unlink(doubly_linked_list* list, d_node* node);
+static bool d_node_copy_chain(const doubly_linked_list* list, const d_node* first, const size_t count,
+                              d_node** out_first, d_node** out_last);
+static void d_node_destroy_chain(d_node* first);
+
+
+static d_node* d_node_initialize(const void* data, const size_t data_size)
+{
+    d_node* node = calloc(1, sizeof(d_node));
+
+    if (!node)
+    {
+        return nullptr;
+    }
+
+    node->data = malloc(data_size);
+
+    if (!node->data)
+    {
+        free(node);
+        return nullptr;
+    }
+
+    /* The data may be filled in by the caller */
+    if (data)
+    {
+        memcpy(node->data, data, data_size);
+    }
+
+    return node;
+}
+
+static bool d_node_destroy(d_node* node)
+{
+    if (!node)
+    {
+        return false;
+    }
+
+    free(node->data);
+    free(node);
+    return true;
+}
+
+/* Walks to the kth node from whichever end is nearer */
+static d_node* d_node_get_kth(const doubly_linked_list* list, const size_t k)
+{
+    if (k >= list->size)
+    {
+        return nullptr;
+    }
+
+    d_node* node;
+
+    if (k < list->size / 2)
+    {
+        node = list->head;
+        for (size_t i = 0; i < k; ++i)
+        {
+            node = node->next;
+        }
+        DS_STATS_COUNT(list, traversal_steps, k);
+    }
+    else
+    {
+        node = list->tail;
+        for (size_t i = list->size - 1; i > k; --i)
+        {
+            node = node->prev;
+        }
+        DS_STATS_COUNT(list, traversal_steps, list->size - 1 - k);
+    }
+
+    return node;
+}
+
+/* Links a node in front of next, or at the tail if next is nullptr. The size is left to the caller. */
+static void d_node_link_before(doubly_linked_list* list, d_node* next, d_node* node)
+{
+    d_node* prev = next ? next->prev : list->tail;
+
+    node->prev = prev;
+    node->next = next;
+
+    if (prev)
+    {
+        prev->next = node;
+    }
+    else
+    {
+        list->head = node;
+    }
+
+    if (next)
+    {
+        next->prev = node;
+    }
+    else
+    {
+        list->tail = node;
+    }
+}
+
+/* Unlinks a node without freeing it. The size is left to the caller. */
+static void d_node_unlink(doubly_linked_list* list, d_node* node)
+{
+    if (node->prev)
+    {
+        node->prev->next = node->next;
+    }
+    else
+    {
+        list->head = node->next;
+    }
+
+    if (node->next)
+    {
+        node->next->prev = node->prev;
+    }
+    else
+    {
+        list->tail = node->prev;
+    }
+
+    node->prev = nullptr;
+    node->next = nullptr;
+}
+
+/* Copies count nodes starting at first into a detached chain, so a failed copy leaves the target list untouched */
+static bool d_node_copy_chain(const doubly_linked_list* list, const d_node* first, const size_t count,
+                              d_node** out_first, d_node** out_last)
+{
+    d_node* head = nullptr;
+    d_node* tail = nullptr;
+    const d_node* current = first;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        d_node* node = d_node_initialize(current->data, list->data_size);
+
+        if (!node)
+        {
+            d_node_destroy_chain(head);
+            return false;
+        }
+
+        node->prev = tail;
+        if (tail)
+        {
+            tail->next = node;
+        }
+        else
+        {
+            head = node;
+        }
+        tail = node;
+
+        current = current->next;
+        DS_STATS_COUNT(list, traversal_steps, 1);
+    }
+
+    *out_first = head;
+    *out_last = tail;
+    return true;
+}
+
+static void d_node_destroy_chain(d_node* first)
+{
+    while (first)
+    {
+        d_node* next = first->next;
+        d_node_destroy(first);
+        first = next;
+    }
+}
+
+/* Links a detached chain of count nodes in front of next, or at the tail if next is nullptr */
+static void d_list_link_chain(doubly_linked_list* list, d_node* next, d_node* first, d_node* last, const size_t count)
+{
+    if (!first)
+    {
+        return;
+    }
+
+    d_node* prev = next ? next->prev : list->tail;
+
+    first->prev = prev;
+    last->next = next;
+
+    if (prev)
+    {
+        prev->next = first;
+    }
+    else
+    {
+        list->head = first;
+    }
+
+    if (next)
+    {
+        next->prev = last;
+    }
+    else
+    {
+        list->tail = last;
+    }
+
+    list->size += count;
+    DS_STATS_COUNT(list, allocations, 2 * count);
+    DS_STATS_COUNT(list, bytes_copied, count * list->data_size);
+    DS_STATS_PEAK(list, list->size);
+}
+
+doubly_linked_list* dlist_initialize(const size_t data_size)
+{
+    if (data_size == 0)
+    {
+        return nullptr;
+    }
+
+    doubly_linked_list* list = calloc(1, sizeof(doubly_linked_list));
+    if (!list)
+    {
+        return nullptr;
+    }
+    list->data_size = data_size;
+    DS_STATS_COUNT(list, allocations, 1);
+    return list;
+}
+
+doubly_linked_list* dlist_initialize_from(const doubly_linked_list* list, const size_t data_size)
+{
+    if ((!list) || (data_size != list->data_size))
+    {
+        return nullptr;
+    }
+
+    doubly_linked_list* new_list = dlist_initialize(data_size);
+
+    if (!new_list)
+    {
+        return nullptr;
+    }
+
+    d_node* first;
+    d_node* last;
+
+    if (!d_node_copy_chain(list, list->head, list->size, &first, &last))
+    {
+        dlist_destroy(new_list);
+        return nullptr;
+    }
+
+    d_list_link_chain(new_list, nullptr, first, last, list->size);
+    return new_list;
+}
+
+bool dlist_destroy(doubly_linked_list* list)
+{
+    if (!list)
+    {
+        return false;
+    }
+
+    d_node_destroy_chain(list->head);
+    free(list);
+    return true;
+}
+
+
+void* dlist_get_first(const doubly_linked_list* list)
+{
+    if ((!list) || (!list->head))
+    {
+        return nullptr;
+    }
+
+    return list->head->data;
+}
+
+void* dlist_get_last(const doubly_linked_list* list)
+{
+    if ((!list) || (!list->tail))
+    {
+        return nullptr;
+    }
+
+    return list->tail->data;
+}
+
+void* dlist_get_at(const doubly_linked_list* list, const size_t index)
+{
+    if ((!list) || (index >= list->size))
+    {
+        return nullptr;
+    }
+
+    return d_node_get_kth(list, index)->data;
+}
+
+doubly_linked_list* dlist_get_sub_list(const doubly_linked_list* list, const size_t start, const size_t end)
+{
+    if ((!list) || (start >= list->size) || (end > list->size) || (start >= end))
+    {
+        return nullptr;
+    }
+
+    doubly_linked_list* sub_list = dlist_initialize(list->data_size);
+
+    if (!sub_list)
+    {
+        return nullptr;
+    }
+
+    d_node* first;
+    d_node* last;
+
+    if (!d_node_copy_chain(list, d_node_get_kth(list, start), end - start, &first, &last))
+    {
+        dlist_destroy(sub_list);
+        return nullptr;
+    }
+
+    d_list_link_chain(sub_list, nullptr, first, last, end - start);
+    return sub_list;
+}
+
+
+// The returned data is owned by the caller and must be freed.
+void* dlist_remove_first(doubly_linked_list* list)
+{
+    if (!list)
+    {
+        return nullptr;
+    }
+
+    return dlist_remove_node(list, list->head);
+}
+
+// The returned data is owned by the caller and must be freed.
+void* dlist_remove_last(doubly_linked_list* list)
+{
+    if (!list)
+    {
+        return nullptr;
+    }
+
+    return dlist_remove_node(list, list->tail);
+}
+
+bool dlist_remove_at(doubly_linked_list* list, const size_t index)
+{
+    if ((!list) || (index >= list->size))
+    {
+        return false;
+    }
+
+    free(dlist_remove_node(list, d_node_get_kth(list, index)));
+    return true;
+}
+
+bool dlist_remove_element(doubly_linked_list* list, const void* data, const size_t data_size)
+{
+    d_node* node = dlist_find_node(list, data, data_size);
+
+    if (!node)
+    {
+        return false;
+    }
+
+    free(dlist_remove_node(list, node));
+    return true;
+}
+
+bool dlist_remove_all(doubly_linked_list* list, const doubly_linked_list* other_list)
+{
+    if ((!list || !other_list) || (list == other_list) || (list->data_size != other_list->data_size))
+    {
+        return false;
+    }
+
+    for (const d_node* current = other_list->head; current; current = current->next)
+    {
+        dlist_remove_element(list, current->data, other_list->data_size);
+    }
+
+    return true;
+}
+
+// The element at index end is excluded and not removed.
+void dlist_remove_range(doubly_linked_list* list, const size_t start, const size_t end)
+{
+    if ((!list) || (start >= list->size) || (end > list->size) || (start >= end))
+    {
+        return;
+    }
+
+    d_node* current = d_node_get_kth(list, start);
+
+    for (size_t i = start; i < end; ++i)
+    {
+        d_node* next = current->next;
+        free(dlist_remove_node(list, current));
+        current = next;
+    }
+}
+
+
+bool dlist_add_first(doubly_linked_list* list, const void* data, const size_t data_size)
+{
+    return dlist_insert(list, 0, data, data_size);
+}
+
+bool dlist_add_last(doubly_linked_list* list, const void* data, const size_t data_size)
+{
+    if (!list)
+    {
+        return false;
+    }
+
+    return dlist_insert(list, list->size, data, data_size);
+}
+
+bool dlist_add_all(doubly_linked_list* list, const doubly_linked_list* other_list)
+{
+    if (!list)
+    {
+        return false;
+    }
+
+    return dlist_add_all_at(list, list->size, other_list);
+}
+
+bool dlist_add_all_at(doubly_linked_list* list, const size_t index, const doubly_linked_list* other_list)
+{
+    if ((!list || !other_list) || (index > list->size) || (list->data_size != other_list->data_size) ||
+        (list->size > SIZE_MAX - other_list->size))
+    {
+        return false;
+    }
+
+    /* The copy is made before linking, which also makes adding a list to itself safe */
+    const size_t count = other_list->size;
+    d_node* first;
+    d_node* last;
+
+    if (!d_node_copy_chain(list, other_list->head, count, &first, &last))
+    {
+        return false;
+    }
+
+    d_list_link_chain(list, (index == list->size) ? nullptr : d_node_get_kth(list, index), first, last, count);
+    return true;
+}
+
+bool dlist_insert(doubly_linked_list* list, const size_t index, const void* data, const size_t data_size)
+{
+    if ((!list || !data) || (list->data_size != data_size) || (index > list->size) || (list->size == SIZE_MAX))
+    {
+        return false;
+    }
+
+    d_node* node = d_node_initialize(data, data_size);
+
+    if (!node)
+    {
+        return false;
+    }
+
+    d_node_link_before(list, (index == list->size) ? nullptr : d_node_get_kth(list, index), node);
+
+    list->size++;
+    DS_STATS_COUNT(list, allocations, 2);
+    DS_STATS_COUNT(list, bytes_copied, data_size);
+    DS_STATS_PEAK(list, list->size);
+    return true;
+}
+
+
+void* dlist_set(doubly_linked_list* list, const size_t index, const void* data, const size_t data_size)
+{
+    if ((!list || !data) || (list->data_size != data_size) || (index >= list->size))
+    {
+        return nullptr;
+    }
+
+    d_node* node = d_node_get_kth(list, index);
+    memcpy(node->data, data, data_size);
+    DS_STATS_COUNT(list, bytes_copied, data_size);
+    return node->data;
+}
+
+
+bool dlist_contains(const doubly_linked_list* list, const void* data, const size_t data_size)
+{
+    return dlist_find_node(list, data, data_size) != nullptr;
+}
+
+bool dlist_index_of(const doubly_linked_list* list, const void* data, const size_t data_size, size_t* index)
+{
+    if ((!list || !data || !index) || (list->data_size != data_size))
+    {
+        return false;
+    }
+
+    size_t i = 0;
+    for (const d_node* current = list->head; current; current = current->next, ++i)
+    {
+        if (!memcmp(current->data, data, data_size))
+        {
+            DS_STATS_COUNT(list, comparisons, i + 1);
+            DS_STATS_COUNT(list, traversal_steps, i);
+            *index = i;
+            return true;
+        }
+    }
+
+    DS_STATS_COUNT(list, comparisons, list->size);
+    DS_STATS_COUNT(list, traversal_steps, list->size);
+    return false;
+}
+
+bool dlist_last_index_of(const doubly_linked_list* list, const void* data, const size_t data_size, size_t* index)
+{
+    if ((!list || !data || !index) || (list->data_size != data_size))
+    {
+        return false;
+    }
+
+    size_t i = list->size;
+    for (const d_node* current = list->tail; current; current = current->prev)
+    {
+        i--;
+        if (!memcmp(current->data, data, data_size))
+        {
+            DS_STATS_COUNT(list, comparisons, list->size - i);
+            DS_STATS_COUNT(list, traversal_steps, list->size - 1 - i);
+            *index = i;
+            return true;
+        }
+    }
+
+    DS_STATS_COUNT(list, comparisons, list->size);
+    DS_STATS_COUNT(list, traversal_steps, list->size);
+    return false;
+}
+
+
+// Note: If the list stores pointers or other lists they should be freed individually before calling dlist_clear()
+// As that would cause a memory leak.
+void dlist_clear(doubly_linked_list* list)
+{
+    if (!list)
+    {
+        return;
+    }
+
+    d_node_destroy_chain(list->head);
+
+    list->head = nullptr;
+    list->tail = nullptr;
+    list->size = 0;
+}
+
+size_t dlist_size(const doubly_linked_list* list)
+{
+    if (!list)
+    {
+        return 0;
+    }
+
+    return list->size;
+}
+
+bool dlist_is_empty(const doubly_linked_list* list)
+{
+    if (!list)
+    {
+        return true;
+    }
+
+    return list->size == 0;
+}
+
+
+void dlist_reverse(doubly_linked_list* list)
+{
+    if (!list)
+    {
+        return;
+    }
+
+    d_node* current = list->head;
+    while (current)
+    {
+        d_node* next = current->next;
+        current->next = current->prev;
+        current->prev = next;
+        current = next;
+    }
+
+    d_node* head = list->head;
+    list->head = list->tail;
+    list->tail = head;
+    DS_STATS_COUNT(list, traversal_steps, list->size);
+}
+
+/* Merges two sorted chains linked through next only, taking from left on ties to stay stable */
+static d_node* d_node_merge(const doubly_linked_list* list, d_node* left, d_node* right,
+                            int (compar)(const void*, const void*))
+{
+    d_node head = {0};
+    d_node* tail = &head;
+
+    while (left && right)
+    {
+        DS_STATS_COUNT(list, comparisons, 1);
+        if (compar(right->data, left->data) < 0)
+        {
+            tail->next = right;
+            right = right->next;
+        }
+        else
+        {
+            tail->next = left;
+            left = left->next;
+        }
+        tail = tail->next;
+    }
+
+    tail->next = left ? left : right;
+    return head.next;
+}
+
+void dlist_sort(doubly_linked_list* list, int (compar)(const void*, const void*))
+{
+    if ((!list) || (!compar) || (list->size < 2))
+    {
+        return;
+    }
+
+    /*
+     * Bottom-up merge sort over next links: runs of width 1, 2, 4... are merged pairwise,
+     * which needs no recursion and no extra memory. The prev links are rebuilt at the end.
+     */
+    d_node* head = list->head;
+    list->tail->next = nullptr;
+
+    for (size_t width = 1; width < list->size; width *= 2)
+    {
+        d_node merged = {0};
+        d_node* merged_tail = &merged;
+        d_node* rest = head;
+
+        while (rest)
+        {
+            d_node* left = rest;
+            d_node* left_end = left;
+            for (size_t i = 1; (i < width) && left_end->next; ++i)
+            {
+                left_end = left_end->next;
+            }
+
+            d_node* right = left_end->next;
+            left_end->next = nullptr;
+
+            d_node* right_end = right;
+            for (size_t i = 1; (i < width) && right_end && right_end->next; ++i)
+            {
+                right_end = right_end->next;
+            }
+
+            rest = right_end ? right_end->next : nullptr;
+            if (right_end)
+            {
+                right_end->next = nullptr;
+            }
+
+            merged_tail->next = d_node_merge(list, left, right, compar);
+            while (merged_tail->next)
+            {
+                merged_tail = merged_tail->next;
+            }
+            DS_STATS_COUNT(list, traversal_steps, width * 2);
+        }
+
+        head = merged.next;
+    }
+
+    d_node* prev = nullptr;
+    for (d_node* current = head; current; current = current->next)
+    {
+        current->prev = prev;
+        prev = current;
+    }
+
+    list->head = head;
+    list->tail = prev;
+}
+
+
+d_node* dlist_first_node(const doubly_linked_list* list)
+{
+    if (!list)
+    {
+        return nullptr;
+    }
+
+    return list->head;
+}
+
+d_node* dlist_last_node(const doubly_linked_list* list)
+{
+    if (!list)
+    {
+        return nullptr;
+    }
+
+    return list->tail;
+}
+
+d_node* dlist_node_next(const d_node* node)
+{
+    if (!node)
+    {
+        return nullptr;
+    }
+
+    return node->next;
+}
+
+d_node* dlist_node_prev(const d_node* node)
+{
+    if (!node)
+    {
+        return nullptr;
+    }
+
+    return node->prev;
+}
+
+void* dlist_node_data(const d_node* node)
+{
+    if (!node)
+    {
+        return nullptr;
+    }
+
+    return node->data;
+}
+
+d_node* dlist_find_node(const doubly_linked_list* list, const void* data, const size_t data_size)
+{
+    if ((!list || !data) || (list->data_size != data_size))
+    {
+        return nullptr;
+    }
+
+    size_t i = 0;
+    for (d_node* current = list->head; current; current = current->next, ++i)
+    {
+        if (!memcmp(current->data, data, data_size))
+        {
+            DS_STATS_COUNT(list, comparisons, i + 1);
+            DS_STATS_COUNT(list, traversal_steps, i);
+            return current;
+        }
+    }
+
+    DS_STATS_COUNT(list, comparisons, list->size);
+    DS_STATS_COUNT(list, traversal_steps, list->size);
+    return nullptr;
+}
+
+// The returned data is owned by the caller and must be freed.
+void* dlist_remove_node(doubly_linked_list* list, d_node* node)
+{
+    if ((!list || !node) || (!list->size))
+    {
+        return nullptr;
+    }
+
+    void* data = node->data;
+
+    d_node_unlink(list, node);
+    list->size--;
+
+    free(node);
+    return data;
+}
+
+bool dlist_move_to_front(doubly_linked_list* list, d_node* node)
+{
+    if ((!list || !node) || (!list->size))
+    {
+        return false;
+    }
+
+    if (node != list->head)
+    {
+        d_node_unlink(list, node);
+        d_node_link_before(list, list->head, node);
+    }
+
+    return true;
+}
+
+bool dlist_move_to_back(doubly_linked_list* list, d_node* node)
+{
+    if ((!list || !node) || (!list->size))
+    {
+        return false;
+    }
+
+    if (node != list->tail)
+    {
+        d_node_unlink(list, node);
+        d_node_link_before(list, nullptr, node);
+    }
+
+    return true;
+}
+
+
+bool dlist_get_stats(const doubly_linked_list* list, ds_stats* out_stats)
+{
+    if (!out_stats)
+    {
+        return false;
+    }
+
+#ifdef DS_STATS
+    if (!list)
+    {
+        return false;
+    }
+
+    ds_stats_load(&list->stats, out_stats);
+    return true;
+#else
+    (void)list;
+    memset(out_stats, 0, sizeof(ds_stats));
+    return false;
+#endif
+}
@@ -0,0 +1,146 @@
+/**************************************************************************
+ *   doubly_linked_list.h  --                                             *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#ifndef _DATASTRUCTURES_DOUBLY_LINKED_LIST_H
+#define _DATASTRUCTURES_DOUBLY_LINKED_LIST_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ds_stats.h"
+
+/*
+ * The singly linked list API with a link to the previous node in every node.
+ * Both ends are removed in O(1), indexed access walks from the nearer end, and nodes
+ * reached through a cursor can be removed or moved to either end in O(1), as an LRU list needs.
+ */
+
+typedef struct doubly_linked_list doubly_linked_list;
+
+/* A node of a list, used as a cursor. It stays valid until it is removed from its list. */
+typedef struct d_node d_node;
+
+
+doubly_linked_list* dlist_initialize(const size_t data_size);
+doubly_linked_list* dlist_initialize_from(const doubly_linked_list* list, const size_t data_size);
+bool dlist_destroy(doubly_linked_list* list);
+
+
+void* dlist_get_first(const doubly_linked_list* list);
+void* dlist_get_last(const doubly_linked_list* list);
+void* dlist_get_at(const doubly_linked_list* list, const size_t index);
+doubly_linked_list* dlist_get_sub_list(const doubly_linked_list* list, const size_t start, const size_t end);
+
+
+// The data returned by the dlist_remove_* functions returning a pointer is owned by the caller and must be freed.
+void* dlist_remove_first(doubly_linked_list* list);
+void* dlist_remove_last(doubly_linked_list* list);
+bool dlist_remove_at(doubly_linked_list* list, const size_t index);
+bool dlist_remove_element(doubly_linked_list* list, const void* data, const size_t data_size);
+bool dlist_remove_all(doubly_linked_list* list, const doubly_linked_list* other_list);
+void dlist_remove_range(doubly_linked_list* list, const size_t start, const size_t end);
+
+
+bool dlist_add_first(doubly_linked_list* list, const void* data, const size_t data_size);
+bool dlist_add_last(doubly_linked_list* list, const void* data, const size_t data_size);
+bool dlist_add_all(doubly_linked_list* list, const doubly_linked_list* other_list);
+bool dlist_add_all_at(doubly_linked_list* list, const size_t index, const doubly_linked_list* other_list);
+bool dlist_insert(doubly_linked_list* list, const size_t index, const void* data, const size_t data_size);
+
+/**
+ * Overwrites an element in place.
+ * @param list The doubly linked list.
+ * @param index The index of the element.
+ * @param data The new element.
+ * @param data_size The size of the element (in bytes).
+ * @returns a pointer to the stored element, or nullptr if the index is out of bounds. */
+void* dlist_set(doubly_linked_list* list, const size_t index, const void* data, const size_t data_size);
+
+
+bool dlist_contains(const doubly_linked_list* list, const void* data, const size_t data_size);
+bool dlist_index_of(const doubly_linked_list* list, const void* data, const size_t data_size, size_t* index);
+
+/**
+ * Finds the last occurrence of an element, searching backwards from the tail.
+ * @param list The doubly linked list.
+ * @param data The element to look for.
+ * @param data_size The size of the element (in bytes).
+ * @param index Receives the index of the element.
+ * @returns true if the element was found, false otherwise. */
+bool dlist_last_index_of(const doubly_linked_list* list, const void* data, const size_t data_size, size_t* index);
+
+
+void dlist_clear(doubly_linked_list* list);
+size_t dlist_size(const doubly_linked_list* list);
+bool dlist_is_empty(const doubly_linked_list* list);
+
+
+void dlist_reverse(doubly_linked_list* list);
+
+/**
+ * Sorts the list with a stable merge sort that relinks the nodes without copying the data.
+ * @param list The doubly linked list.
+ * @param compar The comparison function, as for qsort(). */
+void dlist_sort(doubly_linked_list* list, int (compar)(const void*, const void*));
+
+
+d_node* dlist_first_node(const doubly_linked_list* list);
+d_node* dlist_last_node(const doubly_linked_list* list);
+d_node* dlist_node_next(const d_node* node);
+d_node* dlist_node_prev(const d_node* node);
+void* dlist_node_data(const d_node* node);
+
+/**
+ * Finds the first node holding an element.
+ * @param list The doubly linked list.
+ * @param data The element to look for.
+ * @param data_size The size of the element (in bytes).
+ * @returns the node, or nullptr if the element was not found. */
+d_node* dlist_find_node(const doubly_linked_list* list, const void* data, const size_t data_size);
+
+/**
+ * Unlinks a node of the list in O(1) and frees it.
+ * @param list The doubly linked list holding the node.
+ * @param node The node to remove.
+ * @returns the node's data, owned by the caller and must be freed, or nullptr on failure. */
+void* dlist_remove_node(doubly_linked_list* list, d_node* node);
+
+/**
+ * Moves a node of the list to the front in O(1), the node stays valid.
+ * @param list The doubly linked list holding the node.
+ * @param node The node to move.
+ * @returns true if the node was moved, false otherwise. */
+bool dlist_move_to_front(doubly_linked_list* list, d_node* node);
+
+/**
+ * Moves a node of the list to the back in O(1), the node stays valid.
+ * @param list The doubly linked list holding the node.
+ * @param node The node to move.
+ * @returns true if the node was moved, false otherwise. */
+bool dlist_move_to_back(doubly_linked_list* list, d_node* node);
+
+
+/**
+ * Reads the operation counters of a doubly linked list.
+ * @param list The doubly linked list.
+ * @param out_stats Receives the counters, zeroed when statistics are disabled.
+ * @returns true if the library was built with DS_STATS. */
+bool dlist_get_stats(const doubly_linked_list* list, ds_stats* out_stats);
+
+#endif //_DATASTRUCTURES_DOUBLY_LINKED_LIST_H
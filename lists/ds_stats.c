@@ -0,0 +1,89 @@
+/**************************************************************************
+ *   ds_stats.c  --  This file is part of Data Structures Library.        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#include "ds_stats.h"
+
+#include <string.h>
+
+#ifdef DS_STATS
+
+ds_atomic_stats ds_global_stats;
+
+static void ds_stats_raise_peak(_Atomic uint64_t* peak_capacity, const uint64_t capacity)
+{
+    uint64_t peak = atomic_load_explicit(peak_capacity, memory_order_relaxed);
+
+    while ((capacity > peak) &&
+        !atomic_compare_exchange_weak_explicit(peak_capacity, &peak, capacity,
+                                               memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+}
+
+void ds_stats_update_peak(ds_atomic_stats* stats, const uint64_t capacity)
+{
+    ds_stats_raise_peak(&stats->peak_capacity, capacity);
+    ds_stats_raise_peak(&ds_global_stats.peak_capacity, capacity);
+}
+
+void ds_stats_load(const ds_atomic_stats* stats, ds_stats* out_stats)
+{
+    out_stats->allocations = atomic_load_explicit(&stats->allocations, memory_order_relaxed);
+    out_stats->reallocations = atomic_load_explicit(&stats->reallocations, memory_order_relaxed);
+    out_stats->bytes_copied = atomic_load_explicit(&stats->bytes_copied, memory_order_relaxed);
+    out_stats->bytes_moved = atomic_load_explicit(&stats->bytes_moved, memory_order_relaxed);
+    out_stats->comparisons = atomic_load_explicit(&stats->comparisons, memory_order_relaxed);
+    out_stats->traversal_steps = atomic_load_explicit(&stats->traversal_steps, memory_order_relaxed);
+    out_stats->peak_capacity = atomic_load_explicit(&stats->peak_capacity, memory_order_relaxed);
+}
+
+bool ds_stats_get_global(ds_stats* out_stats)
+{
+    if (!out_stats)
+    {
+        return false;
+    }
+
+    ds_stats_load(&ds_global_stats, out_stats);
+    return true;
+}
+
+void ds_stats_reset_global(void)
+{
+    atomic_store_explicit(&ds_global_stats.allocations, 0, memory_order_relaxed);
+    atomic_store_explicit(&ds_global_stats.reallocations, 0, memory_order_relaxed);
+    atomic_store_explicit(&ds_global_stats.bytes_copied, 0, memory_order_relaxed);
+    atomic_store_explicit(&ds_global_stats.bytes_moved, 0, memory_order_relaxed);
+    atomic_store_explicit(&ds_global_stats.comparisons, 0, memory_order_relaxed);
+    atomic_store_explicit(&ds_global_stats.traversal_steps, 0, memory_order_relaxed);
+    atomic_store_explicit(&ds_global_stats.peak_capacity, 0, memory_order_relaxed);
+}
+
+#else
+
+bool ds_stats_get_global(ds_stats* out_stats)
+{
+    if (out_stats)
+    {
+        memset(out_stats, 0, sizeof(ds_stats));
+    }
+
+    return false;
+}
+
+void ds_stats_reset_global(void)
+{
+}
+
+#endif
@@ -0,0 +1,100 @@
+/**************************************************************************
+ *   ds_stats.h  --  This file is part of Data Structures Library.        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#ifndef _DATASTRUCTURES_DS_STATS_H
+#define _DATASTRUCTURES_DS_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Operation counters and memory statistics.
+ * They are only collected when the library is built with DS_STATS defined,
+ * otherwise the counting macros expand to nothing and the containers carry no counters.
+ */
+
+/* Structure type. */
+typedef struct ds_stats
+{
+    /* The number of heap blocks or mappings allocated */
+    uint64_t allocations;
+    /* The number of times a buffer was resized */
+    uint64_t reallocations;
+    /* The number of element bytes copied in or out of the container */
+    uint64_t bytes_copied;
+    /* The number of element bytes moved inside the container to open or close gaps */
+    uint64_t bytes_moved;
+    /* The number of element comparisons made by searching and sorting */
+    uint64_t comparisons;
+    /* The number of nodes followed while walking a linked list */
+    uint64_t traversal_steps;
+    /* The highest capacity (in elements) reached */
+    uint64_t peak_capacity;
+} ds_stats;
+
+/**
+ * Reads the counters accumulated over every container.
+ * @param out_stats Receives the counters, zeroed when statistics are disabled.
+ * @returns true if the library was built with DS_STATS. */
+bool ds_stats_get_global(ds_stats* out_stats);
+
+/**
+ * Resets the counters accumulated over every container. */
+void ds_stats_reset_global(void);
+
+#ifdef DS_STATS
+
+#include <stdatomic.h>
+
+/* The counters as they are updated, per container and globally, so read-only calls may count concurrently */
+typedef struct ds_atomic_stats
+{
+    _Atomic uint64_t allocations;
+    _Atomic uint64_t reallocations;
+    _Atomic uint64_t bytes_copied;
+    _Atomic uint64_t bytes_moved;
+    _Atomic uint64_t comparisons;
+    _Atomic uint64_t traversal_steps;
+    _Atomic uint64_t peak_capacity;
+} ds_atomic_stats;
+
+extern ds_atomic_stats ds_global_stats;
+
+void ds_stats_update_peak(ds_atomic_stats* stats, const uint64_t capacity);
+
+/* Copies a snapshot of atomic counters into plain ones */
+void ds_stats_load(const ds_atomic_stats* stats, ds_stats* out_stats);
+
+/*
+ * The container's counters live in a ds_atomic_stats member named stats.
+ * Read-only calls count through a const container, so the updates are relaxed atomics.
+ */
+#define DS_STATS_COUNT(container, field, amount)                                                                 \
+    do                                                                                                           \
+    {                                                                                                            \
+        atomic_fetch_add_explicit(&((ds_atomic_stats*)&(container)->stats)->field, (uint64_t)(amount),          \
+                                  memory_order_relaxed);                                                         \
+        atomic_fetch_add_explicit(&ds_global_stats.field, (uint64_t)(amount), memory_order_relaxed);            \
+    } while (0)
+
+#define DS_STATS_PEAK(container, capacity) ds_stats_update_peak((ds_atomic_stats*)&(container)->stats, (capacity))
+
+#else
+
+#define DS_STATS_COUNT(container, field, amount) ((void)(container))
+#define DS_STATS_PEAK(container, capacity) ((void)(container))
+
+#endif
+
+#endif //_DATASTRUCTURES_DS_STATS_H
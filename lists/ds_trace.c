@@ -0,0 +1,895 @@
+/**************************************************************************
+ *   ds_trace.c  --  This file is part of Data Structures Library.        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+/*
+ * Trace format: an 8 byte header ("DSTRACE" followed by the format version), then one record per call.
+ * A record is the operation byte followed by the container id, other id, index and size,
+ * each encoded as an unsigned LEB128 varint, so most records take 5 to 8 bytes.
+ */
+
+#include "ds_trace.h"
+
+#ifdef DS_TRACE
+#include <pthread.h>
+#include <stdatomic.h>
+#endif
+
+/* The longest encoding of a record: the operation byte and four 64 bit varints */
+#define TRACE_RECORD_MAX_BYTES (1 + (4 * 10))
+
+static const unsigned char trace_magic[8] = {'D', 'S', 'T', 'R', 'A', 'C', 'E', 1};
+
+static const char* op_names[DS_TRACE_OP_COUNT] = {
+    "dynarr_initialize_empty",
+    "dynarr_initialize_sized",
+    "dynarr_initialize_large",
+    "dynarr_initialize_from",
+    "dynarr_destroy",
+    "dynarr_get",
+    "dynarr_get_sub_list",
+    "dynarr_remove_at",
+    "dynarr_remove_element",
+    "dynarr_remove_all",
+    "dynarr_remove_range",
+    "dynarr_add",
+    "dynarr_add_all",
+    "dynarr_insert",
+    "dynarr_set",
+    "dynarr_contains",
+    "dynarr_index_of",
+    "dynarr_last_index_of",
+    "dynarr_clear",
+    "dynarr_size",
+    "dynarr_is_empty",
+    "dynarr_ensure_capacity",
+    "dynarr_trim_to_size",
+    "dynarr_sort",
+    "slist_initialize",
+    "slist_initialize_from",
+    "slist_destroy",
+    "slist_get_first",
+    "slist_get_last",
+    "slist_get_at",
+    "slist_get_sub_list",
+    "slist_remove_first",
+    "slist_remove_last",
+    "slist_add_first",
+    "slist_add_last",
+    "slist_clear",
+    "slist_size",
+    "slist_is_empty",
+    "dynarr_snapshot",
+    "dynarr_snapshot_get",
+    "dynarr_snapshot_size",
+    "dynarr_snapshot_destroy",
+    "dynarr_get_at",
+    "dynarr_data",
+    "slist_splice_last",
+    "slist_splice_at",
+    "slist_split_at",
+    "dynarr_data_size",
+};
+
+/* Reader type. */
+typedef struct ds_trace_reader
+{
+    /* The trace file being read */
+    FILE* file;
+} ds_trace_reader;
+
+const char* ds_trace_op_name(const ds_trace_op op)
+{
+    if (((int)op < 0) || (op >= DS_TRACE_OP_COUNT))
+    {
+        return "unknown";
+    }
+
+    return op_names[op];
+}
+
+static bool read_varint(FILE* file, uint64_t* value)
+{
+    *value = 0;
+
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        const int byte = fgetc(file);
+
+        if (byte == EOF)
+        {
+            return false;
+        }
+
+        *value |= (uint64_t)(byte & 0x7F) << shift;
+
+        if (!(byte & 0x80))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+ds_trace_reader* ds_trace_reader_open(const char* path)
+{
+    if (!path)
+    {
+        return nullptr;
+    }
+
+    FILE* file = fopen(path, "rb");
+
+    if (!file)
+    {
+        return nullptr;
+    }
+
+    unsigned char magic[sizeof(trace_magic)];
+
+    if ((fread(magic, 1, sizeof(magic), file) != sizeof(magic)) || memcmp(magic, trace_magic, sizeof(magic)))
+    {
+        fclose(file);
+        return nullptr;
+    }
+
+    ds_trace_reader* reader = calloc(1, sizeof(ds_trace_reader));
+
+    if (!reader)
+    {
+        fclose(file);
+        return nullptr;
+    }
+
+    reader->file = file;
+    return reader;
+}
+
+bool ds_trace_reader_next(ds_trace_reader* reader, ds_trace_record* out_record)
+{
+    if (!reader || !out_record)
+    {
+        return false;
+    }
+
+    const int op = fgetc(reader->file);
+    uint64_t container, other;
+
+    if ((op == EOF) || (op >= DS_TRACE_OP_COUNT) ||
+        !read_varint(reader->file, &container) ||
+        !read_varint(reader->file, &other) ||
+        !read_varint(reader->file, &out_record->index) ||
+        !read_varint(reader->file, &out_record->size) ||
+        (container > UINT32_MAX) || (other > UINT32_MAX))
+    {
+        return false;
+    }
+
+    out_record->op = (ds_trace_op)op;
+    out_record->container = (uint32_t)container;
+    out_record->other = (uint32_t)other;
+    return true;
+}
+
+void ds_trace_reader_close(ds_trace_reader* reader)
+{
+    if (!reader)
+    {
+        return;
+    }
+
+    fclose(reader->file);
+    free(reader);
+}
+
+#ifdef DS_TRACE
+
+/* An id assigned to a live container */
+typedef struct trace_id_entry
+{
+    const void* key;
+    uint32_t id;
+} trace_id_entry;
+
+/* Everything below is guarded by trace_mutex */
+static pthread_mutex_t trace_mutex = PTHREAD_MUTEX_INITIALIZER;
+static FILE* trace_file;
+static unsigned char trace_buffer[1 << 16];
+static size_t trace_buffered;
+
+/* Container ids keyed by address, an open addressing table with linear probing */
+static trace_id_entry* id_table;
+static size_t id_capacity;
+static size_t id_count;
+static uint32_t next_id = 1;
+
+/* Checked before taking the lock, so calls cost a single load while not recording */
+static atomic_bool trace_active;
+static pthread_once_t trace_env_once = PTHREAD_ONCE_INIT;
+
+static size_t id_slot(const void* key)
+{
+    /* Fibonacci hashing of the address, allocations are aligned so the low bits carry little */
+    return (size_t)(((uintptr_t)key * 11400714819323198485ULL) >> 7) & (id_capacity - 1);
+}
+
+static bool id_table_grow(void)
+{
+    const size_t old_capacity = id_capacity;
+    trace_id_entry* old_table = id_table;
+    const size_t new_capacity = old_capacity ? old_capacity << 1 : 64;
+
+    trace_id_entry* new_table = calloc(new_capacity, sizeof(trace_id_entry));
+
+    if (!new_table)
+    {
+        return false;
+    }
+
+    id_table = new_table;
+    id_capacity = new_capacity;
+
+    for (size_t i = 0; i < old_capacity; ++i)
+    {
+        if (old_table[i].key)
+        {
+            size_t slot = id_slot(old_table[i].key);
+
+            while (id_table[slot].key)
+            {
+                slot = (slot + 1) & (id_capacity - 1);
+            }
+
+            id_table[slot] = old_table[i];
+        }
+    }
+
+    free(old_table);
+    return true;
+}
+
+/* Returns the id of a container, assigning a new one to containers not seen before (0 on failure) */
+static uint32_t id_of(const void* key)
+{
+    if (!key)
+    {
+        return 0;
+    }
+
+    if ((id_count + 1 > id_capacity / 2) && !id_table_grow())
+    {
+        return 0;
+    }
+
+    size_t slot = id_slot(key);
+
+    while (id_table[slot].key)
+    {
+        if (id_table[slot].key == key)
+        {
+            return id_table[slot].id;
+        }
+
+        slot = (slot + 1) & (id_capacity - 1);
+    }
+
+    id_table[slot].key = key;
+    id_table[slot].id = next_id++;
+    id_count++;
+    return id_table[slot].id;
+}
+
+/* Forgets a destroyed container, shifting back the entries probed past it */
+static void id_forget(const void* key)
+{
+    if (!key || !id_capacity)
+    {
+        return;
+    }
+
+    size_t slot = id_slot(key);
+
+    while (id_table[slot].key != key)
+    {
+        if (!id_table[slot].key)
+        {
+            return;
+        }
+
+        slot = (slot + 1) & (id_capacity - 1);
+    }
+
+    size_t next = (slot + 1) & (id_capacity - 1);
+
+    while (id_table[next].key)
+    {
+        const size_t home = id_slot(id_table[next].key);
+
+        /* The entry can fill the hole if its home slot is not between the hole and itself */
+        if (((next - home) & (id_capacity - 1)) >= ((next - slot) & (id_capacity - 1)))
+        {
+            id_table[slot] = id_table[next];
+            slot = next;
+        }
+
+        next = (next + 1) & (id_capacity - 1);
+    }
+
+    id_table[slot].key = nullptr;
+    id_table[slot].id = 0;
+    id_count--;
+}
+
+static size_t write_varint(unsigned char* out, uint64_t value)
+{
+    size_t length = 0;
+
+    do
+    {
+        unsigned char byte = value & 0x7F;
+        value >>= 7;
+
+        if (value)
+        {
+            byte |= 0x80;
+        }
+
+        out[length++] = byte;
+    }
+    while (value);
+
+    return length;
+}
+
+static void trace_flush_locked(void)
+{
+    if (trace_file && trace_buffered)
+    {
+        fwrite(trace_buffer, 1, trace_buffered, trace_file);
+    }
+
+    trace_buffered = 0;
+}
+
+static void trace_stop_locked(void)
+{
+    trace_flush_locked();
+
+    if (trace_file)
+    {
+        fclose(trace_file);
+        trace_file = nullptr;
+    }
+
+    atomic_store_explicit(&trace_active, false, memory_order_release);
+}
+
+/* Drops every container id, so a new recording numbers its containers from 1 again */
+static void id_table_reset_locked(void)
+{
+    free(id_table);
+    id_table = nullptr;
+    id_capacity = 0;
+    id_count = 0;
+    next_id = 1;
+}
+
+static bool trace_start_locked(const char* path)
+{
+    trace_stop_locked();
+    id_table_reset_locked();
+
+    trace_file = fopen(path, "wb");
+
+    if (!trace_file)
+    {
+        return false;
+    }
+
+    if (fwrite(trace_magic, 1, sizeof(trace_magic), trace_file) != sizeof(trace_magic))
+    {
+        fclose(trace_file);
+        trace_file = nullptr;
+        return false;
+    }
+
+    atomic_store_explicit(&trace_active, true, memory_order_release);
+    return true;
+}
+
+static void trace_init_from_env(void)
+{
+    atexit(ds_trace_stop);
+
+    const char* path = getenv("DS_TRACE_FILE");
+
+    if (path && *path)
+    {
+        pthread_mutex_lock(&trace_mutex);
+        trace_start_locked(path);
+        pthread_mutex_unlock(&trace_mutex);
+    }
+}
+
+bool ds_trace_start(const char* path)
+{
+    if (!path)
+    {
+        return false;
+    }
+
+    pthread_once(&trace_env_once, trace_init_from_env);
+
+    pthread_mutex_lock(&trace_mutex);
+    const bool res = trace_start_locked(path);
+    pthread_mutex_unlock(&trace_mutex);
+    return res;
+}
+
+void ds_trace_stop(void)
+{
+    pthread_mutex_lock(&trace_mutex);
+    trace_stop_locked();
+    pthread_mutex_unlock(&trace_mutex);
+}
+
+static void trace_record(const ds_trace_op op, const void* container, const void* other,
+                         const uint64_t index, const uint64_t size)
+{
+    pthread_once(&trace_env_once, trace_init_from_env);
+
+    const bool destroys = (op == DS_TRACE_DYNARR_DESTROY) || (op == DS_TRACE_SLIST_DESTROY) ||
+                          (op == DS_TRACE_DYNARR_SNAPSHOT_DESTROY);
+
+    /* Destroyed containers are forgotten even while not recording, a new one may reuse the address */
+    if (!destroys && !atomic_load_explicit(&trace_active, memory_order_acquire))
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&trace_mutex);
+
+    if (trace_file)
+    {
+        unsigned char record[TRACE_RECORD_MAX_BYTES];
+        size_t length = 0;
+
+        record[length++] = (unsigned char)op;
+        length += write_varint(record + length, id_of(container));
+        length += write_varint(record + length, id_of(other));
+        length += write_varint(record + length, index);
+        length += write_varint(record + length, size);
+
+        if (trace_buffered + length > sizeof(trace_buffer))
+        {
+            trace_flush_locked();
+        }
+
+        memcpy(trace_buffer + trace_buffered, record, length);
+        trace_buffered += length;
+    }
+
+    if (destroys)
+    {
+        id_forget(container);
+    }
+
+    pthread_mutex_unlock(&trace_mutex);
+}
+
+/* Searches report where the element was found, so a replay scans as far as the original call did */
+static uint64_t found_index(const bool found, const size_t index)
+{
+    return found ? (uint64_t)index : UINT64_MAX;
+}
+
+dynamic_array* ds_trace_dynarr_initialize_empty(const size_t data_size)
+{
+    dynamic_array* res = dynarr_initialize_empty(data_size);
+
+    if (res)
+    {
+        trace_record(DS_TRACE_DYNARR_INITIALIZE_EMPTY, res, nullptr, 0, data_size);
+    }
+
+    return res;
+}
+
+dynamic_array* ds_trace_dynarr_initialize_sized(const size_t capacity, const size_t data_size)
+{
+    dynamic_array* res = dynarr_initialize_sized(capacity, data_size);
+
+    if (res)
+    {
+        trace_record(DS_TRACE_DYNARR_INITIALIZE_SIZED, res, nullptr, capacity, data_size);
+    }
+
+    return res;
+}
+
+dynamic_array* ds_trace_dynarr_initialize_large(const size_t capacity, const size_t data_size,
+                                               const large_buffer_options* options)
+{
+    dynamic_array* res = dynarr_initialize_large(capacity, data_size, options);
+
+    if (res)
+    {
+        trace_record(DS_TRACE_DYNARR_INITIALIZE_LARGE, res, nullptr, capacity, data_size);
+    }
+
+    return res;
+}
+
+dynamic_array* ds_trace_dynarr_initialize_from(const dynamic_array* list, const size_t data_size)
+{
+    dynamic_array* res = dynarr_initialize_from(list, data_size);
+
+    if (res)
+    {
+        trace_record(DS_TRACE_DYNARR_INITIALIZE_FROM, res, list, 0, data_size);
+    }
+
+    return res;
+}
+
+void ds_trace_dynarr_destroy(dynamic_array* list)
+{
+    trace_record(DS_TRACE_DYNARR_DESTROY, list, nullptr, 0, 0);
+    dynarr_destroy(list);
+}
+
+bool ds_trace_dynarr_get(const dynamic_array* list, const size_t index, void* out_data, const size_t data_size)
+{
+    const bool res = dynarr_get(list, index, out_data, data_size);
+    trace_record(DS_TRACE_DYNARR_GET, list, nullptr, index, data_size);
+    return res;
+}
+
+void* ds_trace_dynarr_get_at(dynamic_array* list, const size_t index)
+{
+    void* res = dynarr_get_at(list, index);
+    trace_record(DS_TRACE_DYNARR_GET_AT, list, nullptr, index, 0);
+    return res;
+}
+
+const void* ds_trace_dynarr_data(const dynamic_array* list)
+{
+    const void* res = dynarr_data(list);
+    trace_record(DS_TRACE_DYNARR_DATA, list, nullptr, 0, 0);
+    return res;
+}
+
+dynamic_array* ds_trace_dynarr_get_sub_list(const dynamic_array* list, const size_t start, const size_t end)
+{
+    dynamic_array* res = dynarr_get_sub_list(list, start, end);
+
+    if (res)
+    {
+        trace_record(DS_TRACE_DYNARR_GET_SUB_LIST, list, res, start, end);
+    }
+
+    return res;
+}
+
+bool ds_trace_dynarr_remove_at(dynamic_array* list, const size_t index, void* out_data, const size_t data_size)
+{
+    const bool res = dynarr_remove_at(list, index, out_data, data_size);
+    trace_record(DS_TRACE_DYNARR_REMOVE_AT, list, nullptr, index, data_size);
+    return res;
+}
+
+// Note: the element is searched twice while tracing, to record which one was removed.
+bool ds_trace_dynarr_remove_element(dynamic_array* list, const void* data, const size_t data_size)
+{
+    size_t index = 0;
+    const bool found = dynarr_index_of(list, data, data_size, &index);
+    const bool res = dynarr_remove_element(list, data, data_size);
+    trace_record(DS_TRACE_DYNARR_REMOVE_ELEMENT, list, nullptr, found_index(found, index), data_size);
+    return res;
+}
+
+bool ds_trace_dynarr_remove_all(dynamic_array* list, const dynamic_array* other_list)
+{
+    const bool res = dynarr_remove_all(list, other_list);
+    trace_record(DS_TRACE_DYNARR_REMOVE_ALL, list, other_list, 0, 0);
+    return res;
+}
+
+void ds_trace_dynarr_remove_range(dynamic_array* list, const size_t start, const size_t end)
+{
+    dynarr_remove_range(list, start, end);
+    trace_record(DS_TRACE_DYNARR_REMOVE_RANGE, list, nullptr, start, end);
+}
+
+bool ds_trace_dynarr_add(dynamic_array* list, const void* data, const size_t data_size)
+{
+    const bool res = dynarr_add(list, data, data_size);
+    trace_record(DS_TRACE_DYNARR_ADD, list, nullptr, 0, data_size);
+    return res;
+}
+
+bool ds_trace_dynarr_add_all(dynamic_array* list, dynamic_array* other_list)
+{
+    const bool res = dynarr_add_all(list, other_list);
+    trace_record(DS_TRACE_DYNARR_ADD_ALL, list, other_list, 0, 0);
+    return res;
+}
+
+bool ds_trace_dynarr_insert(dynamic_array* list, const size_t index, const void* data, const size_t data_size)
+{
+    const bool res = dynarr_insert(list, index, data, data_size);
+    trace_record(DS_TRACE_DYNARR_INSERT, list, nullptr, index, data_size);
+    return res;
+}
+
+bool ds_trace_dynarr_set(dynamic_array* list, const size_t index, const void* data, const size_t data_size)
+{
+    const bool res = dynarr_set(list, index, data, data_size);
+    trace_record(DS_TRACE_DYNARR_SET, list, nullptr, index, data_size);
+    return res;
+}
+
+bool ds_trace_dynarr_contains(const dynamic_array* list, const void* data, const size_t data_size)
+{
+    /* Same scan and result, but reports where the element was found */
+    size_t index = 0;
+    const bool res = dynarr_index_of(list, data, data_size, &index);
+    trace_record(DS_TRACE_DYNARR_CONTAINS, list, nullptr, found_index(res, index), data_size);
+    return res;
+}
+
+bool ds_trace_dynarr_index_of(const dynamic_array* list, const void* data, const size_t data_size, size_t* index)
+{
+    const bool res = dynarr_index_of(list, data, data_size, index);
+    trace_record(DS_TRACE_DYNARR_INDEX_OF, list, nullptr, found_index(res, res ? *index : 0), data_size);
+    return res;
+}
+
+bool ds_trace_dynarr_last_index_of(const dynamic_array* list, const void* data, const size_t data_size,
+                                   size_t* index)
+{
+    const bool res = dynarr_last_index_of(list, data, data_size, index);
+    trace_record(DS_TRACE_DYNARR_LAST_INDEX_OF, list, nullptr, found_index(res, res ? *index : 0), data_size);
+    return res;
+}
+
+void ds_trace_dynarr_clear(dynamic_array* list)
+{
+    dynarr_clear(list);
+    trace_record(DS_TRACE_DYNARR_CLEAR, list, nullptr, 0, 0);
+}
+
+size_t ds_trace_dynarr_size(const dynamic_array* list)
+{
+    const size_t res = dynarr_size(list);
+    trace_record(DS_TRACE_DYNARR_SIZE, list, nullptr, 0, 0);
+    return res;
+}
+
+int ds_trace_dynarr_is_empty(const dynamic_array* list)
+{
+    const int res = dynarr_is_empty(list);
+    trace_record(DS_TRACE_DYNARR_IS_EMPTY, list, nullptr, 0, 0);
+    return res;
+}
+
+size_t ds_trace_dynarr_data_size(const dynamic_array* list)
+{
+    const size_t res = dynarr_data_size(list);
+    trace_record(DS_TRACE_DYNARR_DATA_SIZE, list, nullptr, 0, 0);
+    return res;
+}
+
+bool ds_trace_dynarr_ensure_capacity(dynamic_array* list, const size_t capacity)
+{
+    const bool res = dynarr_ensure_capacity(list, capacity);
+    trace_record(DS_TRACE_DYNARR_ENSURE_CAPACITY, list, nullptr, capacity, 0);
+    return res;
+}
+
+void ds_trace_dynarr_trim_to_size(dynamic_array* list)
+{
+    dynarr_trim_to_size(list);
+    trace_record(DS_TRACE_DYNARR_TRIM_TO_SIZE, list, nullptr, 0, 0);
+}
+
+void ds_trace_dynarr_sort(dynamic_array* list, int (*compar)(const void*, const void*))
+{
+    dynarr_sort(list, compar);
+    trace_record(DS_TRACE_DYNARR_SORT, list, nullptr, 0, 0);
+}
+
+dynamic_array_snapshot* ds_trace_dynarr_snapshot(dynamic_array* list)
+{
+    dynamic_array_snapshot* res = dynarr_snapshot(list);
+
+    if (res)
+    {
+        trace_record(DS_TRACE_DYNARR_SNAPSHOT, list, res, 0, 0);
+    }
+
+    return res;
+}
+
+bool ds_trace_dynarr_snapshot_get(const dynamic_array_snapshot* snapshot, const size_t index, void* out_data,
+                                  const size_t data_size)
+{
+    const bool res = dynarr_snapshot_get(snapshot, index, out_data, data_size);
+    trace_record(DS_TRACE_DYNARR_SNAPSHOT_GET, snapshot, nullptr, index, data_size);
+    return res;
+}
+
+size_t ds_trace_dynarr_snapshot_size(const dynamic_array_snapshot* snapshot)
+{
+    const size_t res = dynarr_snapshot_size(snapshot);
+    trace_record(DS_TRACE_DYNARR_SNAPSHOT_SIZE, snapshot, nullptr, 0, 0);
+    return res;
+}
+
+void ds_trace_dynarr_snapshot_destroy(dynamic_array_snapshot* snapshot)
+{
+    trace_record(DS_TRACE_DYNARR_SNAPSHOT_DESTROY, snapshot, nullptr, 0, 0);
+    dynarr_snapshot_destroy(snapshot);
+}
+
+singly_linked_list* ds_trace_slist_initialize(const size_t data_size)
+{
+    singly_linked_list* res = slist_initialize(data_size);
+
+    if (res)
+    {
+        trace_record(DS_TRACE_SLIST_INITIALIZE, res, nullptr, 0, data_size);
+    }
+
+    return res;
+}
+
+singly_linked_list* ds_trace_slist_initialize_from(const singly_linked_list* list, const size_t data_size)
+{
+    singly_linked_list* res = slist_initialize_from(list, data_size);
+
+    if (res)
+    {
+        trace_record(DS_TRACE_SLIST_INITIALIZE_FROM, res, list, 0, data_size);
+    }
+
+    return res;
+}
+
+bool ds_trace_slist_destroy(singly_linked_list* list)
+{
+    trace_record(DS_TRACE_SLIST_DESTROY, list, nullptr, 0, 0);
+    return slist_destroy(list);
+}
+
+void* ds_trace_slist_get_first(const singly_linked_list* list)
+{
+    void* res = slist_get_first(list);
+    trace_record(DS_TRACE_SLIST_GET_FIRST, list, nullptr, 0, 0);
+    return res;
+}
+
+void* ds_trace_slist_get_last(const singly_linked_list* list)
+{
+    void* res = slist_get_last(list);
+    trace_record(DS_TRACE_SLIST_GET_LAST, list, nullptr, 0, 0);
+    return res;
+}
+
+void* ds_trace_slist_get_at(const singly_linked_list* list, const size_t index)
+{
+    void* res = slist_get_at(list, index);
+    trace_record(DS_TRACE_SLIST_GET_AT, list, nullptr, index, 0);
+    return res;
+}
+
+singly_linked_list* ds_trace_slist_get_sub_list(const singly_linked_list* list, const size_t start, const size_t end)
+{
+    singly_linked_list* res = slist_get_sub_list(list, start, end);
+
+    if (res)
+    {
+        trace_record(DS_TRACE_SLIST_GET_SUB_LIST, list, res, start, end);
+    }
+
+    return res;
+}
+
+void* ds_trace_slist_remove_first(singly_linked_list* list)
+{
+    void* res = slist_remove_first(list);
+    trace_record(DS_TRACE_SLIST_REMOVE_FIRST, list, nullptr, 0, 0);
+    return res;
+}
+
+void* ds_trace_slist_remove_last(singly_linked_list* list)
+{
+    void* res = slist_remove_last(list);
+    trace_record(DS_TRACE_SLIST_REMOVE_LAST, list, nullptr, 0, 0);
+    return res;
+}
+
+bool ds_trace_slist_add_first(singly_linked_list* list, const void* data, const size_t data_size)
+{
+    const bool res = slist_add_first(list, data, data_size);
+    trace_record(DS_TRACE_SLIST_ADD_FIRST, list, nullptr, 0, data_size);
+    return res;
+}
+
+bool ds_trace_slist_add_last(singly_linked_list* list, const void* data, const size_t data_size)
+{
+    const bool res = slist_add_last(list, data, data_size);
+    trace_record(DS_TRACE_SLIST_ADD_LAST, list, nullptr, 0, data_size);
+    return res;
+}
+
+bool ds_trace_slist_splice_last(singly_linked_list* list, singly_linked_list* other_list)
+{
+    const bool res = slist_splice_last(list, other_list);
+    trace_record(DS_TRACE_SLIST_SPLICE_LAST, list, other_list, 0, 0);
+    return res;
+}
+
+bool ds_trace_slist_splice_at(singly_linked_list* list, const size_t index, singly_linked_list* other_list)
+{
+    const bool res = slist_splice_at(list, index, other_list);
+    trace_record(DS_TRACE_SLIST_SPLICE_AT, list, other_list, index, 0);
+    return res;
+}
+
+singly_linked_list* ds_trace_slist_split_at(singly_linked_list* list, const size_t index)
+{
+    singly_linked_list* res = slist_split_at(list, index);
+
+    if (res)
+    {
+        trace_record(DS_TRACE_SLIST_SPLIT_AT, list, res, index, 0);
+    }
+
+    return res;
+}
+
+void ds_trace_slist_clear(singly_linked_list* list)
+{
+    slist_clear(list);
+    trace_record(DS_TRACE_SLIST_CLEAR, list, nullptr, 0, 0);
+}
+
+size_t ds_trace_slist_size(const singly_linked_list* list)
+{
+    const size_t res = slist_size(list);
+    trace_record(DS_TRACE_SLIST_SIZE, list, nullptr, 0, 0);
+    return res;
+}
+
+bool ds_trace_slist_is_empty(const singly_linked_list* list)
+{
+    const bool res = slist_is_empty(list);
+    trace_record(DS_TRACE_SLIST_IS_EMPTY, list, nullptr, 0, 0);
+    return res;
+}
+
+#else
+
+bool ds_trace_start(const char* path)
+{
+    (void)path;
+    return false;
+}
+
+void ds_trace_stop(void)
+{
+}
+
+#endif
@@ -0,0 +1,252 @@
+/**************************************************************************
+ *   ds_trace.h  --  This file is part of Data Structures Library.        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#ifndef _DATASTRUCTURES_DS_TRACE_H
+#define _DATASTRUCTURES_DS_TRACE_H
+
+/*
+ * Workload tracing.
+ * When the library is built with DS_TRACE defined, every public dynarr_* and slist_* call made by
+ * code including the container headers is routed through a shim that records it to a compact binary
+ * trace, which the ds_replay executable re-runs against the library.
+ * Recording starts with ds_trace_start(), or on the first call when DS_TRACE_FILE names a file.
+ * Calls the library makes to itself are not recorded, nor are the parallel operations, whose callbacks
+ * cannot be replayed. Define DS_TRACE_NO_SHIM to call the containers directly from a translation unit.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dynamic_array.h"
+#include "singly_linked_list.h"
+
+/* The traced operations, one per public function */
+typedef enum ds_trace_op
+{
+    DS_TRACE_DYNARR_INITIALIZE_EMPTY,
+    DS_TRACE_DYNARR_INITIALIZE_SIZED,
+    DS_TRACE_DYNARR_INITIALIZE_LARGE,
+    DS_TRACE_DYNARR_INITIALIZE_FROM,
+    DS_TRACE_DYNARR_DESTROY,
+    DS_TRACE_DYNARR_GET,
+    DS_TRACE_DYNARR_GET_SUB_LIST,
+    DS_TRACE_DYNARR_REMOVE_AT,
+    DS_TRACE_DYNARR_REMOVE_ELEMENT,
+    DS_TRACE_DYNARR_REMOVE_ALL,
+    DS_TRACE_DYNARR_REMOVE_RANGE,
+    DS_TRACE_DYNARR_ADD,
+    DS_TRACE_DYNARR_ADD_ALL,
+    DS_TRACE_DYNARR_INSERT,
+    DS_TRACE_DYNARR_SET,
+    DS_TRACE_DYNARR_CONTAINS,
+    DS_TRACE_DYNARR_INDEX_OF,
+    DS_TRACE_DYNARR_LAST_INDEX_OF,
+    DS_TRACE_DYNARR_CLEAR,
+    DS_TRACE_DYNARR_SIZE,
+    DS_TRACE_DYNARR_IS_EMPTY,
+    DS_TRACE_DYNARR_ENSURE_CAPACITY,
+    DS_TRACE_DYNARR_TRIM_TO_SIZE,
+    DS_TRACE_DYNARR_SORT,
+    DS_TRACE_SLIST_INITIALIZE,
+    DS_TRACE_SLIST_INITIALIZE_FROM,
+    DS_TRACE_SLIST_DESTROY,
+    DS_TRACE_SLIST_GET_FIRST,
+    DS_TRACE_SLIST_GET_LAST,
+    DS_TRACE_SLIST_GET_AT,
+    DS_TRACE_SLIST_GET_SUB_LIST,
+    DS_TRACE_SLIST_REMOVE_FIRST,
+    DS_TRACE_SLIST_REMOVE_LAST,
+    DS_TRACE_SLIST_ADD_FIRST,
+    DS_TRACE_SLIST_ADD_LAST,
+    DS_TRACE_SLIST_CLEAR,
+    DS_TRACE_SLIST_SIZE,
+    DS_TRACE_SLIST_IS_EMPTY,
+    DS_TRACE_DYNARR_SNAPSHOT,
+    DS_TRACE_DYNARR_SNAPSHOT_GET,
+    DS_TRACE_DYNARR_SNAPSHOT_SIZE,
+    DS_TRACE_DYNARR_SNAPSHOT_DESTROY,
+    DS_TRACE_DYNARR_GET_AT,
+    DS_TRACE_DYNARR_DATA,
+    DS_TRACE_SLIST_SPLICE_LAST,
+    DS_TRACE_SLIST_SPLICE_AT,
+    DS_TRACE_SLIST_SPLIT_AT,
+    DS_TRACE_DYNARR_DATA_SIZE,
+    DS_TRACE_OP_COUNT
+} ds_trace_op;
+
+/* A traced call, as read back from a trace file */
+typedef struct ds_trace_record
+{
+    /* The operation called */
+    ds_trace_op op;
+    /* The id of the container or snapshot operated on, or created by an initializer (ids start at 1) */
+    uint32_t container;
+    /* The id of the second container involved (source, other list, sub list or snapshot), 0 if none */
+    uint32_t other;
+    /* The index, start or capacity argument, or the index a search found (UINT64_MAX if none) */
+    uint64_t index;
+    /* The data size, or the end of a range */
+    uint64_t size;
+} ds_trace_record;
+
+/* Reader type. */
+typedef struct ds_trace_reader ds_trace_reader;
+
+/**
+ * Starts recording calls to a trace file, replacing any recording in progress.
+ * @param path The path of the trace file, truncated if it exists.
+ * @returns true if the library was built with DS_TRACE and the file could be opened. */
+bool ds_trace_start(const char* path);
+
+/**
+ * Stops recording and flushes the trace file. */
+void ds_trace_stop(void);
+
+/**
+ * Opens a trace file for reading.
+ * @param path The path of the trace file.
+ * @returns a pointer to the reader, or nullptr if the file is not a trace. */
+ds_trace_reader* ds_trace_reader_open(const char* path);
+
+/**
+ * Reads the next record of a trace.
+ * @param reader The trace reader.
+ * @param out_record Receives the record.
+ * @returns true if a record was read, false at the end of the trace. */
+bool ds_trace_reader_next(ds_trace_reader* reader, ds_trace_record* out_record);
+
+/**
+ * Closes a trace reader.
+ * @param reader The trace reader to close. */
+void ds_trace_reader_close(ds_trace_reader* reader);
+
+/**
+ * Names a traced operation.
+ * @param op The operation.
+ * @returns the name of the public function the operation traces. */
+const char* ds_trace_op_name(const ds_trace_op op);
+
+#ifdef DS_TRACE
+
+/* Recording wrappers, called in place of the container functions by the shim below */
+dynamic_array* ds_trace_dynarr_initialize_empty(const size_t data_size);
+dynamic_array* ds_trace_dynarr_initialize_sized(const size_t capacity, const size_t data_size);
+dynamic_array* ds_trace_dynarr_initialize_large(const size_t capacity, const size_t data_size,
+                                               const large_buffer_options* options);
+dynamic_array* ds_trace_dynarr_initialize_from(const dynamic_array* list, const size_t data_size);
+void ds_trace_dynarr_destroy(dynamic_array* list);
+bool ds_trace_dynarr_get(const dynamic_array* list, const size_t index, void* out_data, const size_t data_size);
+void* ds_trace_dynarr_get_at(dynamic_array* list, const size_t index);
+const void* ds_trace_dynarr_data(const dynamic_array* list);
+dynamic_array* ds_trace_dynarr_get_sub_list(const dynamic_array* list, const size_t start, const size_t end);
+bool ds_trace_dynarr_remove_at(dynamic_array* list, const size_t index, void* out_data, const size_t data_size);
+bool ds_trace_dynarr_remove_element(dynamic_array* list, const void* data, const size_t data_size);
+bool ds_trace_dynarr_remove_all(dynamic_array* list, const dynamic_array* other_list);
+void ds_trace_dynarr_remove_range(dynamic_array* list, const size_t start, const size_t end);
+bool ds_trace_dynarr_add(dynamic_array* list, const void* data, const size_t data_size);
+bool ds_trace_dynarr_add_all(dynamic_array* list, dynamic_array* other_list);
+bool ds_trace_dynarr_insert(dynamic_array* list, const size_t index, const void* data, const size_t data_size);
+bool ds_trace_dynarr_set(dynamic_array* list, const size_t index, const void* data, const size_t data_size);
+bool ds_trace_dynarr_contains(const dynamic_array* list, const void* data, const size_t data_size);
+bool ds_trace_dynarr_index_of(const dynamic_array* list, const void* data, const size_t data_size, size_t* index);
+bool ds_trace_dynarr_last_index_of(const dynamic_array* list, const void* data, const size_t data_size,
+                                   size_t* index);
+void ds_trace_dynarr_clear(dynamic_array* list);
+size_t ds_trace_dynarr_size(const dynamic_array* list);
+int ds_trace_dynarr_is_empty(const dynamic_array* list);
+size_t ds_trace_dynarr_data_size(const dynamic_array* list);
+bool ds_trace_dynarr_ensure_capacity(dynamic_array* list, size_t capacity);
+void ds_trace_dynarr_trim_to_size(dynamic_array* list);
+void ds_trace_dynarr_sort(dynamic_array* list, int (*compar)(const void*, const void*));
+dynamic_array_snapshot* ds_trace_dynarr_snapshot(dynamic_array* list);
+bool ds_trace_dynarr_snapshot_get(const dynamic_array_snapshot* snapshot, const size_t index, void* out_data,
+                                  const size_t data_size);
+size_t ds_trace_dynarr_snapshot_size(const dynamic_array_snapshot* snapshot);
+void ds_trace_dynarr_snapshot_destroy(dynamic_array_snapshot* snapshot);
+
+singly_linked_list* ds_trace_slist_initialize(const size_t data_size);
+singly_linked_list* ds_trace_slist_initialize_from(const singly_linked_list* list, const size_t data_size);
+bool ds_trace_slist_destroy(singly_linked_list* list);
+void* ds_trace_slist_get_first(const singly_linked_list* list);
+void* ds_trace_slist_get_last(const singly_linked_list* list);
+void* ds_trace_slist_get_at(const singly_linked_list* list, const size_t index);
+singly_linked_list* ds_trace_slist_get_sub_list(const singly_linked_list* list, const size_t start, const size_t end);
+void* ds_trace_slist_remove_first(singly_linked_list* list);
+void* ds_trace_slist_remove_last(singly_linked_list* list);
+bool ds_trace_slist_add_first(singly_linked_list* list, const void* data, const size_t data_size);
+bool ds_trace_slist_add_last(singly_linked_list* list, const void* data, const size_t data_size);
+bool ds_trace_slist_splice_last(singly_linked_list* list, singly_linked_list* other_list);
+bool ds_trace_slist_splice_at(singly_linked_list* list, const size_t index, singly_linked_list* other_list);
+singly_linked_list* ds_trace_slist_split_at(singly_linked_list* list, const size_t index);
+void ds_trace_slist_clear(singly_linked_list* list);
+size_t ds_trace_slist_size(const singly_linked_list* list);
+bool ds_trace_slist_is_empty(const singly_linked_list* list);
+
+#ifndef DS_TRACE_NO_SHIM
+
+#define dynarr_initialize_empty(...) ds_trace_dynarr_initialize_empty(__VA_ARGS__)
+#define dynarr_initialize_sized(...) ds_trace_dynarr_initialize_sized(__VA_ARGS__)
+#define dynarr_initialize_large(...) ds_trace_dynarr_initialize_large(__VA_ARGS__)
+#define dynarr_initialize_from(...) ds_trace_dynarr_initialize_from(__VA_ARGS__)
+#define dynarr_destroy(...) ds_trace_dynarr_destroy(__VA_ARGS__)
+#define dynarr_get(...) ds_trace_dynarr_get(__VA_ARGS__)
+#define dynarr_get_at(...) ds_trace_dynarr_get_at(__VA_ARGS__)
+#define dynarr_data(...) ds_trace_dynarr_data(__VA_ARGS__)
+#define dynarr_get_sub_list(...) ds_trace_dynarr_get_sub_list(__VA_ARGS__)
+#define dynarr_remove_at(...) ds_trace_dynarr_remove_at(__VA_ARGS__)
+#define dynarr_remove_element(...) ds_trace_dynarr_remove_element(__VA_ARGS__)
+#define dynarr_remove_all(...) ds_trace_dynarr_remove_all(__VA_ARGS__)
+#define dynarr_remove_range(...) ds_trace_dynarr_remove_range(__VA_ARGS__)
+#define dynarr_add(...) ds_trace_dynarr_add(__VA_ARGS__)
+#define dynarr_add_all(...) ds_trace_dynarr_add_all(__VA_ARGS__)
+#define dynarr_insert(...) ds_trace_dynarr_insert(__VA_ARGS__)
+#define dynarr_set(...) ds_trace_dynarr_set(__VA_ARGS__)
+#define dynarr_contains(...) ds_trace_dynarr_contains(__VA_ARGS__)
+#define dynarr_index_of(...) ds_trace_dynarr_index_of(__VA_ARGS__)
+#define dynarr_last_index_of(...) ds_trace_dynarr_last_index_of(__VA_ARGS__)
+#define dynarr_clear(...) ds_trace_dynarr_clear(__VA_ARGS__)
+#define dynarr_size(...) ds_trace_dynarr_size(__VA_ARGS__)
+#define dynarr_is_empty(...) ds_trace_dynarr_is_empty(__VA_ARGS__)
+#define dynarr_data_size(...) ds_trace_dynarr_data_size(__VA_ARGS__)
+#define dynarr_ensure_capacity(...) ds_trace_dynarr_ensure_capacity(__VA_ARGS__)
+#define dynarr_trim_to_size(...) ds_trace_dynarr_trim_to_size(__VA_ARGS__)
+#define dynarr_sort(...) ds_trace_dynarr_sort(__VA_ARGS__)
+#define dynarr_snapshot(...) ds_trace_dynarr_snapshot(__VA_ARGS__)
+#define dynarr_snapshot_get(...) ds_trace_dynarr_snapshot_get(__VA_ARGS__)
+#define dynarr_snapshot_size(...) ds_trace_dynarr_snapshot_size(__VA_ARGS__)
+#define dynarr_snapshot_destroy(...) ds_trace_dynarr_snapshot_destroy(__VA_ARGS__)
+
+#define slist_initialize(...) ds_trace_slist_initialize(__VA_ARGS__)
+#define slist_initialize_from(...) ds_trace_slist_initialize_from(__VA_ARGS__)
+#define slist_destroy(...) ds_trace_slist_destroy(__VA_ARGS__)
+#define slist_get_first(...) ds_trace_slist_get_first(__VA_ARGS__)
+#define slist_get_last(...) ds_trace_slist_get_last(__VA_ARGS__)
+#define slist_get_at(...) ds_trace_slist_get_at(__VA_ARGS__)
+#define slist_get_sub_list(...) ds_trace_slist_get_sub_list(__VA_ARGS__)
+#define slist_remove_first(...) ds_trace_slist_remove_first(__VA_ARGS__)
+#define slist_remove_last(...) ds_trace_slist_remove_last(__VA_ARGS__)
+#define slist_add_first(...) ds_trace_slist_add_first(__VA_ARGS__)
+#define slist_add_last(...) ds_trace_slist_add_last(__VA_ARGS__)
+#define slist_splice_last(...) ds_trace_slist_splice_last(__VA_ARGS__)
+#define slist_splice_at(...) ds_trace_slist_splice_at(__VA_ARGS__)
+#define slist_split_at(...) ds_trace_slist_split_at(__VA_ARGS__)
+#define slist_clear(...) ds_trace_slist_clear(__VA_ARGS__)
+#define slist_size(...) ds_trace_slist_size(__VA_ARGS__)
+#define slist_is_empty(...) ds_trace_slist_is_empty(__VA_ARGS__)
+
+#endif
+
+#endif
+
+#endif //_DATASTRUCTURES_DS_TRACE_H
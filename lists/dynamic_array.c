@@ -13,6 +13,11 @@
  **************************************************************************/
 
 #include "dynamic_array.h"
+#include "ds_stats.h"
+#include "thread_pool.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
 
 /* Structure type. */
 typedef struct DYNAMIC_ARRAY
@@ -25,8 +30,80 @@ typedef struct DYNAMIC_ARRAY
     size_t data_size;
     /* The actual capacity of the allocated memory for the list */
     size_t capacity;
+    /* The number of elements that fit in the inline buffer */
+    size_t inline_capacity;
+    /* Whether the data is a large buffer mapped from the kernel */
+    bool mapped;
+    /* The placement options of a mapped buffer */
+    large_buffer_options large_options;
+    /* The views still shared with snapshots, newest first (nullptr without snapshots) */
+    struct cow_table* cow_tables;
+    /* The largest view size, past which a write touches nothing the snapshots share */
+    size_t cow_shared_size;
+#ifdef DS_STATS
+    /* The operation counters of the list */
+    ds_atomic_stats stats;
+#endif
+    /* Element storage allocated together with the header, used while the list is small */
+    alignas(max_align_t) unsigned char inline_data[];
 } dynamic_array;
 
+/* A chunk copied out of a list before the list wrote over it, shared by every view that still needed it */
+typedef struct cow_chunk
+{
+    /* The number of views referencing the chunk */
+    _Atomic size_t references;
+    alignas(max_align_t) unsigned char data[];
+} cow_chunk;
+
+typedef _Atomic(cow_chunk*) cow_slot;
+
+/*
+ * A view of a list as it was when a snapshot was taken, shared by the snapshots taken before the list's next write.
+ * Its chunks are read from the list's storage until the list first writes to them, which copies them out first.
+ * Snapshots may read a view from any thread, while the list's owner updates it under the view's lock.
+ */
+typedef struct cow_table
+{
+    /* The references held by the snapshots, and by the list while the view is in its chain */
+    _Atomic size_t references;
+    /* Held for writing by the list while it copies out a chunk or moves its storage */
+    pthread_rwlock_t lock;
+    /* The list's storage, read for the chunks not copied out yet (guarded by lock) */
+    const unsigned char* live;
+    /* The number of elements in the view */
+    _Atomic size_t size;
+    /* The size of a single data element in bytes */
+    size_t data_size;
+    /* The number of elements in a chunk */
+    size_t chunk_elements;
+    /* The number of chunks covering the view */
+    size_t chunk_count;
+    /* The copied-out chunk of each index, nullptr while shared with the list (allocated on the first copy) */
+    _Atomic(cow_slot*) chunks;
+    /* Whether the list wrote to the view since it was taken, only used by the list */
+    bool written;
+    /* The next older view in the list's chain, only used by the list */
+    struct cow_table* older;
+} cow_table;
+
+/* Snapshot type. */
+typedef struct DYNAMIC_ARRAY_SNAPSHOT
+{
+    /* The view the snapshot reads */
+    cow_table* table;
+} dynamic_array_snapshot;
+
+static void dynarr_before_write(dynamic_array* list, const size_t start, size_t end);
+static void dynarr_cow_lock(dynamic_array* list);
+static void dynarr_cow_unlock(dynamic_array* list);
+static void dynarr_cow_detach(dynamic_array* list);
+
+
+static bool dynarr_is_inline(const dynamic_array* list)
+{
+    return list->data == list->inline_data;
+}
 
 static dynamic_array* allocate_dynamic_array(const size_t data_size, const size_t capacity)
 {
@@ -35,15 +112,27 @@ static dynamic_array* allocate_dynamic_array(const size_t data_size, const size_
         return nullptr;
     }
 
-    dynamic_array* list = calloc(1, sizeof(dynamic_array));
+    /* The initial storage lives right after the header unless it is too big to be kept around after spilling */
+    const size_t inline_capacity = (capacity <= DYNARR_INLINE_MAX_BYTES / data_size) ? capacity : 0;
+
+    dynamic_array* list = calloc(1, sizeof(dynamic_array) + (inline_capacity * data_size));
 
     if (!list)
     {
         return nullptr;
     }
 
+    list->inline_capacity = inline_capacity;
+
+    if (capacity <= inline_capacity)
+    {
+        list->data = list->inline_data;
+    }
+    else
+    {
+        list->data = calloc(capacity, data_size);
+    }
 
-    list->data = calloc(capacity, data_size);
     list->size = 0;
     list->data_size = data_size;
     list->capacity = capacity;
@@ -54,12 +143,100 @@ static dynamic_array* allocate_dynamic_array(const size_t data_size, const size_
         return nullptr;
     }
 
+    DS_STATS_COUNT(list, allocations, dynarr_is_inline(list) ? 1 : 2);
+    DS_STATS_PEAK(list, capacity);
+
     return list;
 }
 
+/*
+ * Moves the elements to a buffer of new_capacity elements.
+ * Storage spills from the inline buffer to the heap when it no longer fits, and returns to it when it fits again.
+ * Mapped buffers stay mapped and are resized in place by the kernel.
+ */
+static bool dynarr_move_storage(dynamic_array* list, const size_t new_capacity)
+{
+    if (list->mapped)
+    {
+        void* data_ptr = large_buffer_remap(list->data, list->capacity * list->data_size,
+                                            new_capacity * list->data_size, &list->large_options);
+
+        if (!data_ptr)
+        {
+            return false;
+        }
+
+        list->data = data_ptr;
+        list->capacity = new_capacity;
+        DS_STATS_COUNT(list, reallocations, 1);
+        DS_STATS_PEAK(list, new_capacity);
+        return true;
+    }
+
+    if (new_capacity <= list->inline_capacity)
+    {
+        if (!dynarr_is_inline(list))
+        {
+            memcpy(list->inline_data, list->data, list->size * list->data_size);
+            free(list->data);
+            list->data = list->inline_data;
+            DS_STATS_COUNT(list, reallocations, 1);
+            DS_STATS_COUNT(list, bytes_copied, list->size * list->data_size);
+        }
+
+        /* The inline buffer cannot be released, so it is always fully usable */
+        list->capacity = list->inline_capacity;
+        return true;
+    }
+
+    void* data_ptr;
+
+    if (dynarr_is_inline(list))
+    {
+        data_ptr = malloc(new_capacity * list->data_size);
+
+        if (!data_ptr)
+        {
+            return false;
+        }
+
+        memcpy(data_ptr, list->inline_data, list->size * list->data_size);
+        DS_STATS_COUNT(list, allocations, 1);
+        DS_STATS_COUNT(list, bytes_copied, list->size * list->data_size);
+    }
+    else
+    {
+        data_ptr = realloc(list->data, new_capacity * list->data_size);
+
+        if (!data_ptr)
+        {
+            return false;
+        }
+
+        DS_STATS_COUNT(list, reallocations, 1);
+    }
+
+    list->data = data_ptr;
+    list->capacity = new_capacity;
+    DS_STATS_PEAK(list, new_capacity);
+    return true;
+}
+
+static bool dynarr_resize_storage(dynamic_array* list, const size_t new_capacity)
+{
+    /* Moving storage only keeps the elements in use, so snapshots copy out whatever they still need past them */
+    dynarr_before_write(list, list->size, list->capacity);
+
+    /* Snapshots reading chunks still shared wait until they are pointed at the new storage */
+    dynarr_cow_lock(list);
+    const bool res = dynarr_move_storage(list, new_capacity);
+    dynarr_cow_unlock(list);
+    return res;
+}
+
 dynamic_array* dynarr_initialize_empty(const size_t data_size)
 {
-    return allocate_dynamic_array(data_size, DEFAULT_CAPACITY);
+    return allocate_dynamic_array(data_size, DYNARR_INLINE_CAPACITY);
 }
 
 dynamic_array* dynarr_initialize_sized(const size_t capacity, const size_t data_size)
@@ -67,6 +244,42 @@ dynamic_array* dynarr_initialize_sized(const size_t capacity, const size_t data_
     return allocate_dynamic_array(data_size, capacity);
 }
 
+dynamic_array* dynarr_initialize_large(const size_t capacity, const size_t data_size,
+                                      const large_buffer_options* options)
+{
+    if ((data_size == 0) || (capacity > SIZE_MAX / data_size))
+    {
+        return nullptr;
+    }
+
+    dynamic_array* list = calloc(1, sizeof(dynamic_array));
+
+    if (!list)
+    {
+        return nullptr;
+    }
+
+    list->large_options = options ? *options : (large_buffer_options){.huge_pages = true};
+
+    /* The kernel hands out zeroed pages, so the buffer is never cleared eagerly */
+    list->data = large_buffer_map(capacity * data_size, &list->large_options);
+    list->size = 0;
+    list->data_size = data_size;
+    list->capacity = capacity;
+    list->mapped = true;
+
+    if (!list->data)
+    {
+        free(list);
+        return nullptr;
+    }
+
+    DS_STATS_COUNT(list, allocations, 2);
+    DS_STATS_PEAK(list, capacity);
+
+    return list;
+}
+
 dynamic_array* dynarr_initialize_from(const dynamic_array* list, const size_t data_size)
 {
     if ((!list) || (list->data_size != data_size))
@@ -74,7 +287,7 @@ dynamic_array* dynarr_initialize_from(const dynamic_array* list, const size_t da
         return nullptr;
     }
 
-    dynamic_array* new_list = allocate_dynamic_array(data_size, list->capacity);
+    dynamic_array* new_list = allocate_dynamic_array(data_size, list->size);
 
     if (!new_list)
     {
@@ -84,6 +297,7 @@ dynamic_array* dynarr_initialize_from(const dynamic_array* list, const size_t da
     new_list->size = list->size;
 
     memcpy(new_list->data, list->data, new_list->size * new_list->data_size);
+    DS_STATS_COUNT(new_list, bytes_copied, new_list->size * new_list->data_size);
 
     return new_list;
 }
@@ -95,7 +309,18 @@ void dynarr_destroy(dynamic_array* list)
         return;
     }
 
-    free(list->data);
+    /* Live snapshots take their own copy of every chunk they still share */
+    dynarr_cow_detach(list);
+
+    if (list->mapped)
+    {
+        large_buffer_unmap(list->data, list->capacity * list->data_size);
+    }
+    else if (!dynarr_is_inline(list))
+    {
+        free(list->data);
+    }
+
     free(list);
 }
 
@@ -106,17 +331,7 @@ static bool dynarr_expand(dynamic_array* list, const size_t new_capacity)
         return false;
     }
 
-    void* data_ptr = realloc(list->data, new_capacity * list->data_size);
-
-    if (!data_ptr)
-    {
-        return false;
-    }
-
-    list->data = data_ptr;
-
-    list->capacity = new_capacity;
-    return true;
+    return dynarr_resize_storage(list, new_capacity);
 }
 
 static bool dynarr_double_capacity(dynamic_array* list)
@@ -127,7 +342,8 @@ static bool dynarr_double_capacity(dynamic_array* list)
         return false;
     }
 
-    const size_t new_capacity = list->capacity << 1;
+    /* An empty buffer (e.g. after trimming an empty list) cannot be doubled */
+    const size_t new_capacity = list->capacity ? list->capacity << 1 : DEFAULT_CAPACITY;
 
     if (!dynarr_expand(list, new_capacity))
     {
@@ -161,13 +377,9 @@ static bool dynarr_grow_capacity(dynamic_array* list, const size_t extra_capacit
     return true;
 }
 
-bool dynarr_add(dynamic_array* list, const void* data, const size_t data_size)
+/* Grows the list if needed so that one more element fits */
+static bool dynarr_make_room(dynamic_array* list)
 {
-    if ((!list || !data) || (list->data_size != data_size) || (list->capacity == SIZE_MAX / list->data_size))
-    {
-        return false;
-    }
-
     /*
      * list->size should never be > list->capacity in practice
      * we put it here just in case our logic fails somewhere else
@@ -184,13 +396,31 @@ bool dynarr_add(dynamic_array* list, const void* data, const size_t data_size)
         }
     }
 
+    return true;
+}
+
+bool dynarr_add(dynamic_array* list, const void* data, const size_t data_size)
+{
+    if ((!list || !data) || (list->data_size != data_size) || (list->capacity == SIZE_MAX / list->data_size))
+    {
+        return false;
+    }
+
+    if (!dynarr_make_room(list))
+    {
+        return false;
+    }
+
+    dynarr_before_write(list, list->size, list->size + 1);
+
     void* dest = (unsigned char*)(list->data) + (list->size * data_size);
     memcpy(dest, data, data_size);
+    DS_STATS_COUNT(list, bytes_copied, data_size);
     list->size++;
     return true;
 }
 
-static bool shift_elements_right(const dynamic_array* list, const size_t index)
+static bool shift_elements_right(dynamic_array* list, const size_t index)
 {
     if (index >= list->size)
     {
@@ -203,6 +433,7 @@ static bool shift_elements_right(const dynamic_array* list, const size_t index)
     const void* src = (unsigned char*)(list->data) + (index * data_size);
     const size_t numbytes = (list->size - index) * data_size;
     memmove(dest, src, numbytes);
+    DS_STATS_COUNT(list, bytes_moved, numbytes);
     return true;
 }
 
@@ -213,18 +444,29 @@ bool dynarr_set(dynamic_array* list, const size_t index, const void* data, const
         return false;
     }
 
+    dynarr_before_write(list, index, index + 1);
+
     void* dest = (unsigned char*)(list->data) + (index * data_size);
     memcpy(dest, data, data_size);
+    DS_STATS_COUNT(list, bytes_copied, data_size);
     return true;
 }
 
 bool dynarr_insert(dynamic_array* list, const size_t index, const void* data, const size_t data_size)
 {
-    if ((!list || !data) || (index >= list->size) || (list->data_size != data_size))
+    if ((!list || !data) || (index >= list->size) || (list->data_size != data_size) ||
+        (list->capacity == SIZE_MAX / list->data_size))
+    {
+        return false;
+    }
+
+    if (!dynarr_make_room(list))
     {
         return false;
     }
 
+    dynarr_before_write(list, index, list->size + 1);
+
     if (!shift_elements_right(list, index))
     {
         return false;
@@ -258,9 +500,12 @@ bool dynarr_add_all(dynamic_array* list, dynamic_array* other_list)
         }
     }
 
+    dynarr_before_write(list, list->size, list->size + other_list->size);
+
     const void* src = (unsigned char*)(other_list->data);
     void* dest = (unsigned char*)(list->data) + (list->size * list->data_size);
     memcpy(dest, src, other_list->data_size * other_list->size);
+    DS_STATS_COUNT(list, bytes_copied, other_list->data_size * other_list->size);
     list->size += other_list->size;
     return true;
 }
@@ -289,9 +534,11 @@ bool dynarr_contains(const dynamic_array* list, const void* data, const size_t d
         const void* src = (unsigned char*)(list->data) + (i * data_size);
         if (!memcmp(data, src, data_size))
         {
+            DS_STATS_COUNT(list, comparisons, i + 1);
             return true;
         }
     }
+    DS_STATS_COUNT(list, comparisons, list->size);
     return false;
 }
 
@@ -305,15 +552,7 @@ bool dynarr_ensure_capacity(dynamic_array* list, const size_t capacity)
 
     if (list->capacity != capacity)
     {
-        void* data_ptr = realloc(list->data, list->data_size * capacity);
-
-        if (!data_ptr)
-        {
-            return false;
-        }
-
-        list->data = data_ptr;
-        list->capacity = capacity;
+        return dynarr_resize_storage(list, capacity);
     }
     return true;
 }
@@ -326,9 +565,33 @@ bool dynarr_get(const dynamic_array* list, const size_t index, void* out_data, c
     }
 
     memcpy(out_data, (unsigned char*)(list->data) + (index * list->data_size), data_size);
+    DS_STATS_COUNT(list, bytes_copied, data_size);
     return true;
 }
 
+void* dynarr_get_at(dynamic_array* list, const size_t index)
+{
+    if ((!list) || (index >= list->size))
+    {
+        return nullptr;
+    }
+
+    /* The caller may write through the pointer */
+    dynarr_before_write(list, index, index + 1);
+
+    return (unsigned char*)(list->data) + (index * list->data_size);
+}
+
+const void* dynarr_data(const dynamic_array* list)
+{
+    if (!list)
+    {
+        return nullptr;
+    }
+
+    return list->data;
+}
+
 bool dynarr_index_of(const dynamic_array* list, const void* data, const size_t data_size, size_t* index)
 {
     if ((!list || !data || !index) || (list->data_size != data_size))
@@ -341,11 +604,13 @@ bool dynarr_index_of(const dynamic_array* list, const void* data, const size_t d
         const void* src = (unsigned char*)(list->data) + (i * data_size);
         if (!memcmp(data, src, data_size))
         {
+            DS_STATS_COUNT(list, comparisons, i + 1);
             *index = i;
             return true;
         }
     }
 
+    DS_STATS_COUNT(list, comparisons, list->size);
     return false;
 }
 
@@ -366,11 +631,13 @@ bool dynarr_last_index_of(const dynamic_array* list, const void* data, const siz
         const void* src = (unsigned char*)(list->data) + ((i - 1) * data_size);
         if (!memcmp(data, src, data_size))
         {
+            DS_STATS_COUNT(list, comparisons, list->size - i + 1);
             *index = i - 1;
             return true;
         }
     }
 
+    DS_STATS_COUNT(list, comparisons, list->size);
     return false;
 }
 
@@ -384,12 +651,16 @@ bool dynarr_remove_at(dynamic_array* list, const size_t index, void* out_data, c
     const void* element_src = (unsigned char*)(list->data) + (index * list->data_size);
     memcpy(out_data, element_src, list->data_size);
 
+    dynarr_before_write(list, index, list->size);
+    DS_STATS_COUNT(list, bytes_copied, list->data_size);
+
     if (index < list->size - 1)
     {
         const void* src = (unsigned char*)(list->data) + ((index + 1) * list->data_size);
         void* dest = (unsigned char*)(list->data) + (index * list->data_size);
         const size_t buffer_size = (list->size - index - 1) * list->data_size;
         memmove(dest, src, buffer_size);
+        DS_STATS_COUNT(list, bytes_moved, buffer_size);
     }
 
     list->size--;
@@ -457,11 +728,14 @@ void dynarr_remove_range(dynamic_array* list, const size_t start, const size_t e
         return;
     }
 
+    dynarr_before_write(list, start, list->size);
+
     const void* src = (unsigned char*)(list->data) + (end * list->data_size);
     void* dest = (unsigned char*)(list->data) + (start * list->data_size);
-    const size_t numbytes = (end - start) * list->data_size;
+    const size_t numbytes = (list->size - end) * list->data_size;
 
     memmove(dest, src, numbytes);
+    DS_STATS_COUNT(list, bytes_moved, numbytes);
 
     list->size -= (end - start);
 
@@ -471,6 +745,28 @@ void dynarr_remove_range(dynamic_array* list, const size_t start, const size_t e
     }
 }
 
+bool dynarr_get_stats(const dynamic_array* list, ds_stats* out_stats)
+{
+    if (!out_stats)
+    {
+        return false;
+    }
+
+#ifdef DS_STATS
+    if (!list)
+    {
+        return false;
+    }
+
+    ds_stats_load(&list->stats, out_stats);
+    return true;
+#else
+    (void)list;
+    memset(out_stats, 0, sizeof(ds_stats));
+    return false;
+#endif
+}
+
 size_t dynarr_size(const dynamic_array* list)
 {
     if (!list)
@@ -481,6 +777,28 @@ size_t dynarr_size(const dynamic_array* list)
     return list->size;
 }
 
+size_t dynarr_data_size(const dynamic_array* list)
+{
+    if (!list)
+    {
+        return 0;
+    }
+
+    return list->data_size;
+}
+
+#ifdef DS_STATS
+/* qsort() passes no context, so the comparator being counted is kept per thread */
+static thread_local int (*counted_compar)(const void*, const void*);
+static thread_local uint64_t counted_comparisons;
+
+static int dynarr_counting_compar(const void* a, const void* b)
+{
+    counted_comparisons++;
+    return counted_compar(a, b);
+}
+#endif
+
 void dynarr_sort(dynamic_array* list, int (*compar)(const void*, const void*))
 {
     if ((!list || !compar) || (list->size == 0))
@@ -488,7 +806,16 @@ void dynarr_sort(dynamic_array* list, int (*compar)(const void*, const void*))
         return;
     }
 
+    dynarr_before_write(list, 0, list->size);
+
+#ifdef DS_STATS
+    counted_compar = compar;
+    counted_comparisons = 0;
+    qsort(list->data, list->size, list->data_size, dynarr_counting_compar);
+    DS_STATS_COUNT(list, comparisons, counted_comparisons);
+#else
     qsort(list->data, list->size, list->data_size, compar);
+#endif
 }
 
 dynamic_array* dynarr_get_sub_list(const dynamic_array* list, const size_t start, const size_t end)
@@ -510,6 +837,7 @@ dynamic_array* dynarr_get_sub_list(const dynamic_array* list, const size_t start
 
     const void* src = (unsigned char*)(list->data) + (start * list->data_size);
     memcpy(res->data, src, sub_list_size * res->data_size);
+    DS_STATS_COUNT(res, bytes_copied, sub_list_size * res->data_size);
 
     res->size = sub_list_size;
 
@@ -525,3 +853,609 @@ void dynarr_trim_to_size(dynamic_array* list)
 
     dynarr_ensure_capacity(list, list->size);
 }
+
+/* The grain and threshold of the parallel operations, shared by every list */
+static _Atomic size_t parallel_grain = DYNARR_PARALLEL_GRAIN;
+static _Atomic size_t parallel_threshold = DYNARR_PARALLEL_THRESHOLD;
+
+void dynarr_parallel_set_grain(const size_t grain)
+{
+    atomic_store_explicit(&parallel_grain, grain ? grain : DYNARR_PARALLEL_GRAIN, memory_order_relaxed);
+}
+
+void dynarr_parallel_set_threshold(const size_t threshold)
+{
+    atomic_store_explicit(&parallel_threshold, threshold ? threshold : DYNARR_PARALLEL_THRESHOLD,
+                          memory_order_relaxed);
+}
+
+static bool dynarr_runs_serially(const dynamic_array* list)
+{
+    return list->size < atomic_load_explicit(&parallel_threshold, memory_order_relaxed);
+}
+
+/* The number of chunks covering the list, without the overflow of rounding up when the grain is near SIZE_MAX */
+static size_t dynarr_chunk_count(const dynamic_array* list, const size_t grain)
+{
+    return (list->size / grain) + ((list->size % grain) != 0);
+}
+
+/* The elements [begin, end) of a chunk, clamped to the list */
+static void dynarr_chunk_bounds(const dynamic_array* list, const size_t grain, const size_t chunk,
+                                size_t* begin, size_t* end)
+{
+    *begin = chunk * grain;
+    *end = (list->size - *begin < grain) ? list->size : *begin + grain;
+}
+
+/* The state shared by the chunks of a parallel operation */
+typedef struct parallel_job
+{
+    const dynamic_array* list;
+    size_t grain;
+    void* ctx;
+    void (*for_fn)(void* element, size_t index, void* ctx);
+    void (*accumulate)(void* acc, const void* element, void* ctx);
+    bool (*predicate)(const void* element, void* ctx);
+    /* One accumulator per chunk (reduce) */
+    unsigned char* partials;
+    size_t result_size;
+    /* Whether each element matched, the number of matches and the output offset of each chunk (filter) */
+    unsigned char* matches;
+    size_t* counts;
+    dynamic_array* out;
+} parallel_job;
+
+static void parallel_for_task(const size_t first_chunk, const size_t last_chunk, void* arg)
+{
+    const parallel_job* job = arg;
+
+    for (size_t chunk = first_chunk; chunk < last_chunk; ++chunk)
+    {
+        size_t begin, end;
+        dynarr_chunk_bounds(job->list, job->grain, chunk, &begin, &end);
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            job->for_fn((unsigned char*)(job->list->data) + (i * job->list->data_size), i, job->ctx);
+        }
+    }
+}
+
+static void parallel_reduce_task(const size_t first_chunk, const size_t last_chunk, void* arg)
+{
+    const parallel_job* job = arg;
+
+    for (size_t chunk = first_chunk; chunk < last_chunk; ++chunk)
+    {
+        size_t begin, end;
+        dynarr_chunk_bounds(job->list, job->grain, chunk, &begin, &end);
+        void* acc = job->partials + (chunk * job->result_size);
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            job->accumulate(acc, (unsigned char*)(job->list->data) + (i * job->list->data_size), job->ctx);
+        }
+    }
+}
+
+static void parallel_filter_count_task(const size_t first_chunk, const size_t last_chunk, void* arg)
+{
+    const parallel_job* job = arg;
+
+    for (size_t chunk = first_chunk; chunk < last_chunk; ++chunk)
+    {
+        size_t begin, end;
+        dynarr_chunk_bounds(job->list, job->grain, chunk, &begin, &end);
+        size_t count = 0;
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            const bool match = job->predicate((unsigned char*)(job->list->data) + (i * job->list->data_size),
+                                              job->ctx);
+            job->matches[i] = match;
+            count += match;
+        }
+
+        job->counts[chunk] = count;
+    }
+}
+
+static void parallel_filter_copy_task(const size_t first_chunk, const size_t last_chunk, void* arg)
+{
+    const parallel_job* job = arg;
+    const size_t data_size = job->list->data_size;
+
+    for (size_t chunk = first_chunk; chunk < last_chunk; ++chunk)
+    {
+        size_t begin, end;
+        dynarr_chunk_bounds(job->list, job->grain, chunk, &begin, &end);
+        unsigned char* dest = (unsigned char*)(job->out->data) + (job->counts[chunk] * data_size);
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (job->matches[i])
+            {
+                memcpy(dest, (unsigned char*)(job->list->data) + (i * data_size), data_size);
+                dest += data_size;
+            }
+        }
+    }
+}
+
+bool dynarr_parallel_for(dynamic_array* list, void (*fn)(void* element, size_t index, void* ctx), void* ctx)
+{
+    if ((!list || !fn))
+    {
+        return false;
+    }
+
+    dynarr_before_write(list, 0, list->size);
+
+    const size_t grain = atomic_load_explicit(&parallel_grain, memory_order_relaxed);
+    parallel_job job = {.list = list, .grain = grain, .ctx = ctx, .for_fn = fn};
+    const size_t chunks = dynarr_chunk_count(list, grain);
+
+    if (dynarr_runs_serially(list))
+    {
+        parallel_for_task(0, chunks, &job);
+    }
+    else
+    {
+        thread_pool_parallel_for(chunks, parallel_for_task, &job);
+    }
+
+    return true;
+}
+
+bool dynarr_parallel_reduce(const dynamic_array* list, void* out_result, const size_t result_size,
+                            const void* identity,
+                            void (*accumulate)(void* acc, const void* element, void* ctx),
+                            void (*combine)(void* acc, const void* partial, void* ctx),
+                            void* ctx)
+{
+    if ((!list || !out_result || !identity || !accumulate || !combine) || (result_size == 0))
+    {
+        return false;
+    }
+
+    memcpy(out_result, identity, result_size);
+
+    if (dynarr_runs_serially(list))
+    {
+        for (size_t i = 0; i < list->size; ++i)
+        {
+            accumulate(out_result, (unsigned char*)(list->data) + (i * list->data_size), ctx);
+        }
+
+        return true;
+    }
+
+    const size_t grain = atomic_load_explicit(&parallel_grain, memory_order_relaxed);
+    const size_t chunks = dynarr_chunk_count(list, grain);
+
+    if (chunks > SIZE_MAX / result_size)
+    {
+        return false;
+    }
+
+    unsigned char* partials = malloc(chunks * result_size);
+
+    if (!partials)
+    {
+        return false;
+    }
+
+    for (size_t chunk = 0; chunk < chunks; ++chunk)
+    {
+        memcpy(partials + (chunk * result_size), identity, result_size);
+    }
+
+    parallel_job job = {
+        .list = list, .grain = grain, .ctx = ctx, .accumulate = accumulate,
+        .partials = partials, .result_size = result_size
+    };
+    thread_pool_parallel_for(chunks, parallel_reduce_task, &job);
+
+    for (size_t chunk = 0; chunk < chunks; ++chunk)
+    {
+        combine(out_result, partials + (chunk * result_size), ctx);
+    }
+
+    free(partials);
+    return true;
+}
+
+dynamic_array* dynarr_parallel_filter(const dynamic_array* list, bool (*predicate)(const void* element, void* ctx),
+                                      void* ctx)
+{
+    if ((!list || !predicate))
+    {
+        return nullptr;
+    }
+
+    if (dynarr_runs_serially(list))
+    {
+        dynamic_array* res = dynarr_initialize_empty(list->data_size);
+
+        for (size_t i = 0; res && (i < list->size); ++i)
+        {
+            const void* element = (unsigned char*)(list->data) + (i * list->data_size);
+
+            if (predicate(element, ctx) && !dynarr_add(res, element, list->data_size))
+            {
+                dynarr_destroy(res);
+                res = nullptr;
+            }
+        }
+
+        return res;
+    }
+
+    const size_t grain = atomic_load_explicit(&parallel_grain, memory_order_relaxed);
+    const size_t chunks = dynarr_chunk_count(list, grain);
+
+    unsigned char* matches = malloc(list->size);
+    size_t* counts = malloc(chunks * sizeof(size_t));
+
+    if (!matches || !counts)
+    {
+        free(matches);
+        free(counts);
+        return nullptr;
+    }
+
+    parallel_job job = {
+        .list = list, .grain = grain, .ctx = ctx, .predicate = predicate,
+        .matches = matches, .counts = counts
+    };
+    thread_pool_parallel_for(chunks, parallel_filter_count_task, &job);
+
+    /* Turns the per-chunk counts into output offsets */
+    size_t total = 0;
+
+    for (size_t chunk = 0; chunk < chunks; ++chunk)
+    {
+        const size_t count = counts[chunk];
+        counts[chunk] = total;
+        total += count;
+    }
+
+    dynamic_array* res = dynarr_initialize_sized(total, list->data_size);
+
+    if (res)
+    {
+        job.out = res;
+        thread_pool_parallel_for(chunks, parallel_filter_copy_task, &job);
+        res->size = total;
+        DS_STATS_COUNT(res, bytes_copied, total * list->data_size);
+    }
+
+    free(matches);
+    free(counts);
+    return res;
+}
+
+static void cow_chunk_release(cow_chunk* chunk)
+{
+    if (chunk && (atomic_fetch_sub_explicit(&chunk->references, 1, memory_order_acq_rel) == 1))
+    {
+        free(chunk);
+    }
+}
+
+/* Gives up a reference to a view, the last one frees it along with its copied-out chunks */
+static void cow_table_release(cow_table* table)
+{
+    if (atomic_fetch_sub_explicit(&table->references, 1, memory_order_acq_rel) != 1)
+    {
+        return;
+    }
+
+    cow_slot* chunks = atomic_load_explicit(&table->chunks, memory_order_acquire);
+
+    for (size_t c = 0; chunks && (c < table->chunk_count); ++c)
+    {
+        cow_chunk_release(atomic_load_explicit(&chunks[c], memory_order_relaxed));
+    }
+
+    free(chunks);
+    pthread_rwlock_destroy(&table->lock);
+    free(table);
+}
+
+/* Copies a chunk of the list's storage, clamped to the elements a view can still read from it */
+static cow_chunk* cow_chunk_copy(dynamic_array* list, const size_t chunk, const size_t chunk_elements)
+{
+    const size_t shared_end = (list->cow_shared_size < list->capacity) ? list->cow_shared_size : list->capacity;
+    const size_t chunk_start = chunk * chunk_elements;
+    const size_t chunk_end = (shared_end - chunk_start < chunk_elements) ? shared_end : chunk_start + chunk_elements;
+    const size_t bytes = (chunk_end - chunk_start) * list->data_size;
+
+    cow_chunk* copy = malloc(sizeof(cow_chunk) + bytes);
+
+    if (!copy)
+    {
+        return nullptr;
+    }
+
+    /* The reference of the caller, given up once every view that needed the copy took its own */
+    atomic_init(&copy->references, 1);
+    memcpy(copy->data, (unsigned char*)(list->data) + (chunk_start * list->data_size), bytes);
+    DS_STATS_COUNT(list, allocations, 1);
+    DS_STATS_COUNT(list, bytes_copied, bytes);
+    return copy;
+}
+
+/* Points a view's chunk at its copy, or cuts the view short at that chunk if there is no copy */
+static void cow_table_set_chunk(cow_table* table, const size_t chunk, cow_chunk* copy)
+{
+    pthread_rwlock_wrlock(&table->lock);
+
+    cow_slot* chunks = atomic_load_explicit(&table->chunks, memory_order_relaxed);
+
+    if (copy && !chunks)
+    {
+        chunks = calloc(table->chunk_count, sizeof(cow_slot));
+        atomic_store_explicit(&table->chunks, chunks, memory_order_release);
+    }
+
+    if (copy && chunks)
+    {
+        atomic_fetch_add_explicit(&copy->references, 1, memory_order_relaxed);
+        atomic_store_explicit(&chunks[chunk], copy, memory_order_release);
+    }
+    else if (atomic_load_explicit(&table->size, memory_order_relaxed) > chunk * table->chunk_elements)
+    {
+        /* Without memory for the copy the view cannot stay consistent, so it is cut short */
+        atomic_store_explicit(&table->size, chunk * table->chunk_elements, memory_order_relaxed);
+    }
+
+    table->written = true;
+    pthread_rwlock_unlock(&table->lock);
+}
+
+/*
+ * Copies a chunk out for the views that still read it from the list, newest first.
+ * A view that already has its own copy was taken before the write that made it, and so were the older ones,
+ * so the walk stops there. In particular a write to a chunk already copied since the newest snapshot costs one load.
+ */
+static void dynarr_cow_copy_chunk(dynamic_array* list, const size_t chunk)
+{
+    cow_chunk* copy = nullptr;
+    bool copied = false;
+
+    for (cow_table* table = list->cow_tables; table; table = table->older)
+    {
+        if ((chunk >= table->chunk_count) ||
+            (atomic_load_explicit(&table->size, memory_order_relaxed) <= chunk * table->chunk_elements))
+        {
+            continue;
+        }
+
+        const cow_slot* chunks = atomic_load_explicit(&table->chunks, memory_order_relaxed);
+
+        if (chunks && atomic_load_explicit(&chunks[chunk], memory_order_relaxed))
+        {
+            break;
+        }
+
+        if (!copied)
+        {
+            copy = cow_chunk_copy(list, chunk, table->chunk_elements);
+            copied = true;
+        }
+
+        cow_table_set_chunk(table, chunk, copy);
+    }
+
+    cow_chunk_release(copy);
+}
+
+/* Called before the elements [start, end) of the list are overwritten, moved or discarded */
+static void dynarr_before_write(dynamic_array* list, const size_t start, size_t end)
+{
+    if (!list->cow_tables)
+    {
+        return;
+    }
+
+    /* Nothing past the largest view is shared */
+    if (end > list->cow_shared_size)
+    {
+        end = list->cow_shared_size;
+    }
+
+    if (start >= end)
+    {
+        return;
+    }
+
+    const size_t chunk_elements = list->cow_tables->chunk_elements;
+
+    for (size_t c = start / chunk_elements; c <= (end - 1) / chunk_elements; ++c)
+    {
+        dynarr_cow_copy_chunk(list, c);
+    }
+}
+
+/* Keeps the snapshots from reading the list's storage while it moves */
+static void dynarr_cow_lock(dynamic_array* list)
+{
+    for (cow_table* table = list->cow_tables; table; table = table->older)
+    {
+        pthread_rwlock_wrlock(&table->lock);
+    }
+}
+
+static void dynarr_cow_unlock(dynamic_array* list)
+{
+    for (cow_table* table = list->cow_tables; table; table = table->older)
+    {
+        table->live = list->data;
+        pthread_rwlock_unlock(&table->lock);
+    }
+}
+
+/* Drops the views no snapshot reads anymore */
+static void dynarr_cow_prune(dynamic_array* list)
+{
+    cow_table** link = &list->cow_tables;
+    list->cow_shared_size = 0;
+
+    while (*link)
+    {
+        cow_table* table = *link;
+
+        if (atomic_load_explicit(&table->references, memory_order_acquire) == 1)
+        {
+            *link = table->older;
+            cow_table_release(table);
+            continue;
+        }
+
+        const size_t size = atomic_load_explicit(&table->size, memory_order_relaxed);
+
+        if (size > list->cow_shared_size)
+        {
+            list->cow_shared_size = size;
+        }
+
+        link = &table->older;
+    }
+}
+
+/* Copies out every chunk still shared and lets go of the views, which then no longer read the list */
+static void dynarr_cow_detach(dynamic_array* list)
+{
+    dynarr_before_write(list, 0, SIZE_MAX);
+
+    while (list->cow_tables)
+    {
+        cow_table* table = list->cow_tables;
+        list->cow_tables = table->older;
+        cow_table_release(table);
+    }
+
+    list->cow_shared_size = 0;
+}
+
+dynamic_array_snapshot* dynarr_snapshot(dynamic_array* list)
+{
+    if (!list)
+    {
+        return nullptr;
+    }
+
+    dynamic_array_snapshot* snapshot = malloc(sizeof(dynamic_array_snapshot));
+
+    if (!snapshot)
+    {
+        return nullptr;
+    }
+
+    dynarr_cow_prune(list);
+
+    /* Snapshots taken without a write in between share a view */
+    cow_table* table = list->cow_tables;
+
+    if ((!table) || (table->written) || (atomic_load_explicit(&table->size, memory_order_relaxed) != list->size))
+    {
+        table = calloc(1, sizeof(cow_table));
+
+        if ((!table) || (pthread_rwlock_init(&table->lock, nullptr) != 0))
+        {
+            free(table);
+            free(snapshot);
+            return nullptr;
+        }
+
+        /* The chunk table is only allocated once the list copies out a chunk */
+        atomic_init(&table->references, 1);
+        atomic_init(&table->size, list->size);
+        atomic_init(&table->chunks, nullptr);
+        table->live = list->data;
+        table->data_size = list->data_size;
+        table->chunk_elements = (list->data_size < DYNARR_COW_CHUNK_BYTES) ? DYNARR_COW_CHUNK_BYTES / list->data_size : 1;
+        table->chunk_count = (list->size / table->chunk_elements) + ((list->size % table->chunk_elements) != 0);
+        table->older = list->cow_tables;
+        list->cow_tables = table;
+
+        if (list->size > list->cow_shared_size)
+        {
+            list->cow_shared_size = list->size;
+        }
+    }
+
+    atomic_fetch_add_explicit(&table->references, 1, memory_order_relaxed);
+    snapshot->table = table;
+    return snapshot;
+}
+
+bool dynarr_snapshot_get(const dynamic_array_snapshot* snapshot, const size_t index, void* out_data,
+                         const size_t data_size)
+{
+    if ((!snapshot) || (snapshot->table->data_size != data_size) || !out_data)
+    {
+        return false;
+    }
+
+    cow_table* table = snapshot->table;
+    const size_t c = index / table->chunk_elements;
+
+    if (index >= atomic_load_explicit(&table->size, memory_order_relaxed))
+    {
+        return false;
+    }
+
+    /* A copied-out chunk never changes, so it is read without the lock */
+    const cow_slot* chunks = atomic_load_explicit(&table->chunks, memory_order_acquire);
+    const cow_chunk* chunk = chunks ? atomic_load_explicit(&chunks[c], memory_order_acquire) : nullptr;
+
+    if (chunk)
+    {
+        memcpy(out_data, chunk->data + ((index - (c * table->chunk_elements)) * data_size), data_size);
+        return true;
+    }
+
+    /* The list copies a chunk out before writing to it, which waits until the read below is done */
+    pthread_rwlock_rdlock(&table->lock);
+
+    bool res = index < atomic_load_explicit(&table->size, memory_order_relaxed);
+    chunks = atomic_load_explicit(&table->chunks, memory_order_acquire);
+    chunk = chunks ? atomic_load_explicit(&chunks[c], memory_order_acquire) : nullptr;
+
+    if (res && chunk)
+    {
+        memcpy(out_data, chunk->data + ((index - (c * table->chunk_elements)) * data_size), data_size);
+    }
+    else if (res)
+    {
+        memcpy(out_data, table->live + (index * data_size), data_size);
+    }
+
+    pthread_rwlock_unlock(&table->lock);
+    return res;
+}
+
+size_t dynarr_snapshot_size(const dynamic_array_snapshot* snapshot)
+{
+    if (!snapshot)
+    {
+        return 0;
+    }
+
+    return atomic_load_explicit(&snapshot->table->size, memory_order_relaxed);
+}
+
+void dynarr_snapshot_destroy(dynamic_array_snapshot* snapshot)
+{
+    if (!snapshot)
+    {
+        return;
+    }
+
+    /* The list drops views nobody reads anymore on its next snapshot */
+    cow_table_release(snapshot->table);
+    free(snapshot);
+}
@@ -21,14 +21,53 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "ds_stats.h"
+#include "large_buffer.h"
+
 /* The Default capacity for the list */
 #define DEFAULT_CAPACITY 2
 
+/*
+ * The number of elements stored inline, in the same allocation as the list header,
+ * by dynarr_initialize_empty(). Small lists never allocate a second heap block.
+ * Can be overridden at build time (e.g. -DDYNARR_INLINE_CAPACITY=16).
+ */
+#ifndef DYNARR_INLINE_CAPACITY
+#define DYNARR_INLINE_CAPACITY DEFAULT_CAPACITY
+#endif
+
+/*
+ * The largest initial buffer (in bytes) that is allocated together with the list header.
+ * Bigger initial capacities get a separate heap block, as the inline buffer is never released.
+ */
+#ifndef DYNARR_INLINE_MAX_BYTES
+#define DYNARR_INLINE_MAX_BYTES 4096
+#endif
+
+/* The size of the chunks a snapshot copies out of its list before they are overwritten (in bytes) */
+#ifndef DYNARR_COW_CHUNK_BYTES
+#define DYNARR_COW_CHUNK_BYTES 4096
+#endif
+
+/* The default number of elements handed to a thread at a time by the parallel operations */
+#ifndef DYNARR_PARALLEL_GRAIN
+#define DYNARR_PARALLEL_GRAIN 4096
+#endif
+
+/* The default size below which the parallel operations run serially */
+#ifndef DYNARR_PARALLEL_THRESHOLD
+#define DYNARR_PARALLEL_THRESHOLD 32768
+#endif
+
 /* Structure type. */
 typedef struct DYNAMIC_ARRAY dynamic_array;
 
+/* Snapshot type. */
+typedef struct DYNAMIC_ARRAY_SNAPSHOT dynamic_array_snapshot;
+
 /**
- * Initializes an empty dynamic array of capacity @DEFAULT_CAPACITY.
+ * Initializes an empty dynamic array of capacity @DYNARR_INLINE_CAPACITY.
+ * The header and the initial storage share a single allocation.
  *
  * @param data_size The size of the data type to be stored in the list (in bytes).
  * @returns a pointer to the dynamic array initialized. */
@@ -36,13 +75,26 @@ dynamic_array* dynarr_initialize_empty(const size_t data_size);
 
 /**
  * Initializes a dynamic array with a specified capacity.
+ * The initial storage shares the header allocation if it fits in @DYNARR_INLINE_MAX_BYTES.
  * @param capacity The initial capacity of the list.
  * @param data_size The size of the data type to be stored in the list (in bytes).
  * @returns a pointer to the dynamic array initialized. */
 dynamic_array* dynarr_initialize_sized(const size_t capacity, const size_t data_size);
 
+/**
+ * Initializes a dynamic array whose buffer is mapped directly from the kernel, for very large lists.
+ * The buffer is not zeroed eagerly, can use transparent huge pages and NUMA placement,
+ * and grows with mremap() instead of copying.
+ * @param capacity The initial capacity of the list.
+ * @param data_size The size of the data type to be stored in the list (in bytes).
+ * @param options The placement options of the buffer, nullptr for huge pages with the default NUMA policy.
+ * @returns a pointer to the dynamic array initialized. */
+dynamic_array* dynarr_initialize_large(const size_t capacity, const size_t data_size,
+                                      const large_buffer_options* options);
+
 /**
  * Initializes a dynamic array from another list.
+ * Only the elements are copied, the new list is sized to hold them.
  * @param list The list from which to initialize.
  * @param data_size The size of the data type to be stored in the list (in bytes).
  * @returns a pointer to the dynamic array initialized. */
@@ -55,6 +107,22 @@ void dynarr_destroy(dynamic_array* list);
 
 
 bool dynarr_get(const dynamic_array* list, const size_t index, void* out_data, const size_t data_size);
+
+/**
+ * Returns a pointer to an element, which may be modified in place.
+ * The pointer is invalidated by any call that adds, inserts or removes elements.
+ * @param list The dynamic array.
+ * @param index The index of the element.
+ * @returns a pointer to the element, or nullptr if the index is out of bounds. */
+void* dynarr_get_at(dynamic_array* list, const size_t index);
+
+/**
+ * Returns the elements as a contiguous read-only buffer of dynarr_size() elements.
+ * The pointer is invalidated by any call that modifies the list.
+ * @param list The dynamic array.
+ * @returns a pointer to the first element. */
+const void* dynarr_data(const dynamic_array* list);
+
 dynamic_array* dynarr_get_sub_list(const dynamic_array* list, const size_t start, const size_t end);
 
 
@@ -81,6 +149,12 @@ void dynarr_clear(dynamic_array* list);
 size_t dynarr_size(const dynamic_array* list);
 int dynarr_is_empty(const dynamic_array* list);
 
+/**
+ * Returns the size of the elements the list was initialized with.
+ * @param list The dynamic array.
+ * @returns the size of an element (in bytes), or 0 if @list is nullptr. */
+size_t dynarr_data_size(const dynamic_array* list);
+
 
 bool dynarr_ensure_capacity(dynamic_array* list, size_t capacity);
 void dynarr_trim_to_size(dynamic_array* list);
@@ -88,4 +162,95 @@ void dynarr_trim_to_size(dynamic_array* list);
 
 void dynarr_sort(dynamic_array* list, int (*compar)(const void*, const void*));
 
+
+/**
+ * Takes a read-only, point-in-time snapshot of a dynamic array in O(1).
+ * The snapshot shares the list's storage. The first time the list overwrites, moves or releases a chunk of
+ * @DYNARR_COW_CHUNK_BYTES the snapshot still shares, that chunk alone is copied, once for all the snapshots
+ * that need it. Later writes to the same chunk copy nothing. Snapshots outlive their list.
+ * Snapshots may be read and destroyed from any thread while the list's own thread modifies it.
+ * @param list The dynamic array.
+ * @returns a pointer to the snapshot, or nullptr on failure. */
+dynamic_array_snapshot* dynarr_snapshot(dynamic_array* list);
+
+/**
+ * Copies an element of a snapshot.
+ * @param snapshot The snapshot.
+ * @param index The index of the element.
+ * @param out_data Receives the element.
+ * @param data_size The size of the data type stored in the list (in bytes).
+ * @returns true on success. */
+bool dynarr_snapshot_get(const dynamic_array_snapshot* snapshot, const size_t index, void* out_data,
+                         const size_t data_size);
+
+/**
+ * Returns the number of elements in a snapshot. */
+size_t dynarr_snapshot_size(const dynamic_array_snapshot* snapshot);
+
+/**
+ * Destroys a snapshot and releases the chunks it copied.
+ * @param snapshot The snapshot to be destroyed. */
+void dynarr_snapshot_destroy(dynamic_array_snapshot* snapshot);
+
+
+/**
+ * Calls a function on every element in place, in parallel on the library thread pool.
+ * The elements are not copied, and the function may modify the element it is given.
+ * @param list The dynamic array.
+ * @param fn The function called with a pointer to each element, its index and @ctx.
+ * @param ctx The context passed to the function.
+ * @returns true on success. */
+bool dynarr_parallel_for(dynamic_array* list, void (*fn)(void* element, size_t index, void* ctx), void* ctx);
+
+/**
+ * Reduces the elements to a single value, in parallel on the library thread pool.
+ * Every chunk of elements is accumulated into its own copy of @identity, and the partial results
+ * are then combined in index order, so @combine needs to be associative but not commutative.
+ * @param list The dynamic array.
+ * @param out_result Receives the result, @result_size bytes.
+ * @param result_size The size of the result and of the accumulators (in bytes).
+ * @param identity The initial value of every accumulator.
+ * @param accumulate Adds an element to an accumulator.
+ * @param combine Adds a partial result to an accumulator.
+ * @param ctx The context passed to @accumulate and @combine.
+ * @returns true on success. */
+bool dynarr_parallel_reduce(const dynamic_array* list, void* out_result, const size_t result_size,
+                            const void* identity,
+                            void (*accumulate)(void* acc, const void* element, void* ctx),
+                            void (*combine)(void* acc, const void* partial, void* ctx),
+                            void* ctx);
+
+/**
+ * Copies the elements matching a predicate to a new list, in parallel on the library thread pool.
+ * The elements keep their relative order.
+ * @param list The dynamic array.
+ * @param predicate Returns true for the elements to keep.
+ * @param ctx The context passed to the predicate.
+ * @returns a pointer to the new dynamic array, or nullptr on failure. */
+dynamic_array* dynarr_parallel_filter(const dynamic_array* list, bool (*predicate)(const void* element, void* ctx),
+                                      void* ctx);
+
+/**
+ * Sets the number of elements handed to a thread at a time by the parallel operations.
+ * @param grain The number of elements, 0 to restore @DYNARR_PARALLEL_GRAIN. */
+void dynarr_parallel_set_grain(const size_t grain);
+
+/**
+ * Sets the size below which the parallel operations run serially on the calling thread.
+ * @param threshold The number of elements, 0 to restore @DYNARR_PARALLEL_THRESHOLD. */
+void dynarr_parallel_set_threshold(const size_t threshold);
+
+
+/**
+ * Reads the operation counters of a dynamic array.
+ * @param list The dynamic array.
+ * @param out_stats Receives the counters, zeroed when statistics are disabled.
+ * @returns true if the library was built with DS_STATS. */
+bool dynarr_get_stats(const dynamic_array* list, ds_stats* out_stats);
+
+/* Routes the calls of including code through the workload tracing shim */
+#ifdef DS_TRACE
+#include "ds_trace.h"
+#endif
+
 #endif //_DATASTRUCTURES_DYNAMIC_ARRAY_H
@@ -0,0 +1,359 @@
+/**************************************************************************
+ *   intrusive_slist.c  --                                                *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#include "intrusive_slist.h"
+#include "ds_stats.h"
+
+
+/* Intrusive singly linked list */
+typedef struct intrusive_slist
+{
+    /* The link of the first object */
+    islist_link* head;
+    /* The link of the last object */
+    islist_link* tail;
+    /* The number of objects in the list */
+    size_t size;
+    /* The offset of the link inside the objects */
+    size_t link_offset;
+#ifdef DS_STATS
+    /* The operation counters of the list */
+    ds_atomic_stats stats;
+#endif
+} intrusive_slist;
+
+
+static islist_link* islist_link_of(const intrusive_slist* list, const void* object)
+{
+    return (islist_link*)((unsigned char*)object + list->link_offset);
+}
+
+static void* islist_object_of(const intrusive_slist* list, const islist_link* link)
+{
+    return link ? (unsigned char*)link - list->link_offset : nullptr;
+}
+
+intrusive_slist* islist_initialize(const size_t link_offset)
+{
+    intrusive_slist* list = calloc(1, sizeof(intrusive_slist));
+    if (!list)
+    {
+        return nullptr;
+    }
+    list->link_offset = link_offset;
+    DS_STATS_COUNT(list, allocations, 1);
+    return list;
+}
+
+bool islist_destroy(intrusive_slist* list)
+{
+    if (!list)
+    {
+        return false;
+    }
+
+    free(list);
+    return true;
+}
+
+
+void* islist_get_first(const intrusive_slist* list)
+{
+    if (!list)
+    {
+        return nullptr;
+    }
+
+    return islist_object_of(list, list->head);
+}
+
+void* islist_get_last(const intrusive_slist* list)
+{
+    if (!list)
+    {
+        return nullptr;
+    }
+
+    return islist_object_of(list, list->tail);
+}
+
+void* islist_next(const intrusive_slist* list, const void* object)
+{
+    if ((!list) || (!object))
+    {
+        return nullptr;
+    }
+
+    return islist_object_of(list, islist_link_of(list, object)->next);
+}
+
+
+bool islist_push_first(intrusive_slist* list, void* object)
+{
+    return islist_insert_after(list, nullptr, object);
+}
+
+bool islist_push_last(intrusive_slist* list, void* object)
+{
+    if (!list)
+    {
+        return false;
+    }
+
+    return islist_insert_after(list, islist_object_of(list, list->tail), object);
+}
+
+void* islist_pop_first(intrusive_slist* list)
+{
+    return islist_remove_after(list, nullptr);
+}
+
+bool islist_insert_after(intrusive_slist* list, void* position, void* object)
+{
+    if ((!list || !object) || (list->size == SIZE_MAX))
+    {
+        return false;
+    }
+
+    islist_link* link = islist_link_of(list, object);
+
+    if (position)
+    {
+        islist_link* previous = islist_link_of(list, position);
+        link->next = previous->next;
+        previous->next = link;
+    }
+    else
+    {
+        link->next = list->head;
+        list->head = link;
+    }
+
+    if (!link->next)
+    {
+        list->tail = link;
+    }
+
+    list->size++;
+    DS_STATS_PEAK(list, list->size);
+    return true;
+}
+
+void* islist_remove_after(intrusive_slist* list, void* position)
+{
+    if ((!list) || (!list->size))
+    {
+        return nullptr;
+    }
+
+    islist_link* previous = position ? islist_link_of(list, position) : nullptr;
+    islist_link* link = previous ? previous->next : list->head;
+
+    if (!link)
+    {
+        return nullptr;
+    }
+
+    if (previous)
+    {
+        previous->next = link->next;
+    }
+    else
+    {
+        list->head = link->next;
+    }
+
+    if (list->tail == link)
+    {
+        list->tail = previous;
+    }
+
+    link->next = nullptr;
+    list->size--;
+    return islist_object_of(list, link);
+}
+
+bool islist_splice(intrusive_slist* list, intrusive_slist* other_list)
+{
+    if ((!list || !other_list) || (list == other_list) || (list->link_offset != other_list->link_offset) ||
+        (list->size > SIZE_MAX - other_list->size))
+    {
+        return false;
+    }
+
+    if (!other_list->head)
+    {
+        return true;
+    }
+
+    if (list->tail)
+    {
+        list->tail->next = other_list->head;
+    }
+    else
+    {
+        list->head = other_list->head;
+    }
+
+    list->tail = other_list->tail;
+    list->size += other_list->size;
+    DS_STATS_PEAK(list, list->size);
+
+    other_list->head = nullptr;
+    other_list->tail = nullptr;
+    other_list->size = 0;
+    return true;
+}
+
+
+// The objects are only forgotten, they are still owned by the caller.
+void islist_clear(intrusive_slist* list)
+{
+    if (!list)
+    {
+        return;
+    }
+
+    list->head = nullptr;
+    list->tail = nullptr;
+    list->size = 0;
+}
+
+size_t islist_size(const intrusive_slist* list)
+{
+    if (!list)
+    {
+        return 0;
+    }
+
+    return list->size;
+}
+
+bool islist_is_empty(const intrusive_slist* list)
+{
+    if (!list)
+    {
+        return true;
+    }
+
+    return list->size == 0;
+}
+
+
+/* Merges two sorted chains, taking from left on ties to stay stable */
+static islist_link* islist_merge(const intrusive_slist* list, islist_link* left, islist_link* right,
+                                 int (compar)(const void*, const void*))
+{
+    islist_link head = {nullptr};
+    islist_link* tail = &head;
+
+    while (left && right)
+    {
+        DS_STATS_COUNT(list, comparisons, 1);
+        if (compar(islist_object_of(list, right), islist_object_of(list, left)) < 0)
+        {
+            tail->next = right;
+            right = right->next;
+        }
+        else
+        {
+            tail->next = left;
+            left = left->next;
+        }
+        tail = tail->next;
+    }
+
+    tail->next = left ? left : right;
+    return head.next;
+}
+
+/* Detaches the first count links of a chain and returns the rest */
+static islist_link* islist_cut(islist_link* first, const size_t count)
+{
+    for (size_t i = 1; (i < count) && first; ++i)
+    {
+        first = first->next;
+    }
+
+    if (!first)
+    {
+        return nullptr;
+    }
+
+    islist_link* rest = first->next;
+    first->next = nullptr;
+    return rest;
+}
+
+void islist_sort(intrusive_slist* list, int (compar)(const void*, const void*))
+{
+    if ((!list) || (!compar) || (list->size < 2))
+    {
+        return;
+    }
+
+    /* Bottom-up merge sort: runs of width 1, 2, 4... are merged pairwise without recursion or extra memory */
+    islist_link* head = list->head;
+    islist_link* tail = nullptr;
+
+    for (size_t width = 1; width < list->size; width *= 2)
+    {
+        islist_link merged = {nullptr};
+        tail = &merged;
+        islist_link* rest = head;
+
+        while (rest)
+        {
+            islist_link* left = rest;
+            islist_link* right = islist_cut(left, width);
+            rest = islist_cut(right, width);
+
+            tail->next = islist_merge(list, left, right, compar);
+            while (tail->next)
+            {
+                tail = tail->next;
+            }
+            DS_STATS_COUNT(list, traversal_steps, width * 2);
+        }
+
+        head = merged.next;
+    }
+
+    list->head = head;
+    list->tail = tail;
+}
+
+
+bool islist_get_stats(const intrusive_slist* list, ds_stats* out_stats)
+{
+    if (!out_stats)
+    {
+        return false;
+    }
+
+#ifdef DS_STATS
+    if (!list)
+    {
+        return false;
+    }
+
+    ds_stats_load(&list->stats, out_stats);
+    return true;
+#else
+    (void)list;
+    memset(out_stats, 0, sizeof(ds_stats));
+    return false;
+#endif
+}
@@ -0,0 +1,115 @@
+/**************************************************************************
+ *   intrusive_slist.h  --                                                *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#ifndef _DATASTRUCTURES_INTRUSIVE_SLIST_H
+#define _DATASTRUCTURES_INTRUSIVE_SLIST_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ds_stats.h"
+
+/*
+ * A singly linked list of objects owned by the caller. Each object embeds an islist_link member,
+ * and the list is told that member's offset, so linking and unlinking never allocate or copy:
+ * the list only rewrites the links. An object can be in as many lists as it has links,
+ * but each link can be in one list at a time. The list never frees the objects.
+ */
+
+/* The link to embed in the objects */
+typedef struct islist_link
+{
+    struct islist_link* next;
+} islist_link;
+
+/* The offset to pass to islist_initialize() for the link @member of @type */
+#define ISLIST_OFFSET(type, member) offsetof(type, member)
+
+typedef struct intrusive_slist intrusive_slist;
+
+
+/**
+ * Initializes an empty intrusive list.
+ * @param link_offset The offset of the islist_link member in the objects, see ISLIST_OFFSET().
+ * @returns a pointer to the intrusive list initialized. */
+intrusive_slist* islist_initialize(const size_t link_offset);
+
+/**
+ * Destroys an intrusive list. The objects still in it are left untouched.
+ * @param list The intrusive list to be destroyed. */
+bool islist_destroy(intrusive_slist* list);
+
+
+void* islist_get_first(const intrusive_slist* list);
+void* islist_get_last(const intrusive_slist* list);
+
+/**
+ * Returns the object following another one.
+ * @param list The intrusive list holding @object.
+ * @param object An object of the list.
+ * @returns the next object, or nullptr at the end of the list. */
+void* islist_next(const intrusive_slist* list, const void* object);
+
+
+bool islist_push_first(intrusive_slist* list, void* object);
+bool islist_push_last(intrusive_slist* list, void* object);
+void* islist_pop_first(intrusive_slist* list);
+
+/**
+ * Links an object after another one in O(1).
+ * @param list The intrusive list.
+ * @param position An object of the list, or nullptr to link @object first.
+ * @param object The object to link, which must not be in a list through the same link.
+ * @returns true if the object was linked, false otherwise. */
+bool islist_insert_after(intrusive_slist* list, void* position, void* object);
+
+/**
+ * Unlinks the object following another one in O(1).
+ * @param list The intrusive list.
+ * @param position An object of the list, or nullptr to unlink the first object.
+ * @returns the unlinked object, or nullptr if @position is the last object. */
+void* islist_remove_after(intrusive_slist* list, void* position);
+
+/**
+ * Moves every object of another list to the end of a list in O(1), leaving the other list empty.
+ * @param list The intrusive list receiving the objects.
+ * @param other_list The intrusive list giving its objects, linked through the same member.
+ * @returns true if the objects were moved, false otherwise. */
+bool islist_splice(intrusive_slist* list, intrusive_slist* other_list);
+
+
+void islist_clear(intrusive_slist* list);
+size_t islist_size(const intrusive_slist* list);
+bool islist_is_empty(const intrusive_slist* list);
+
+/**
+ * Sorts the objects with a stable merge sort that only rewrites the links.
+ * @param list The intrusive list.
+ * @param compar The comparison function, called on two objects. */
+void islist_sort(intrusive_slist* list, int (compar)(const void*, const void*));
+
+
+/**
+ * Reads the operation counters of an intrusive list.
+ * @param list The intrusive list.
+ * @param out_stats Receives the counters, zeroed when statistics are disabled.
+ * @returns true if the library was built with DS_STATS. */
+bool islist_get_stats(const intrusive_slist* list, ds_stats* out_stats);
+
+#endif //_DATASTRUCTURES_INTRUSIVE_SLIST_H
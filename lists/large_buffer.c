@@ -0,0 +1,391 @@
+/**************************************************************************
+ *   large_buffer.c  --  This file is part of Data Structures Library.    *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#define _GNU_SOURCE
+
+#include "large_buffer.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+
+#include <stdio.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/* Memory policy modes from <linux/mempolicy.h>, which is not always installed */
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
+#ifndef MPOL_INTERLEAVE
+#define MPOL_INTERLEAVE 3
+#endif
+
+/* The alignment that lets the kernel back the buffer with 2 MiB transparent huge pages */
+#define HUGE_PAGE_SIZE ((size_t)2 << 20)
+
+/* The highest number of NUMA nodes considered */
+#define MAX_NUMA_NODES 1024
+#define NODE_MASK_WORDS (MAX_NUMA_NODES / (8 * sizeof(unsigned long)))
+
+/* A range of pages faulted in by one first-touch thread */
+typedef struct touch_range
+{
+    unsigned char* start;
+    unsigned char* end;
+    size_t page_size;
+} touch_range;
+
+static size_t page_size(void)
+{
+    const long size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? (size_t)size : 4096;
+}
+
+static size_t round_to_pages(const size_t bytes)
+{
+    const size_t page = page_size();
+
+    /* Zero-sized mappings are not allowed */
+    if (bytes == 0)
+    {
+        return page;
+    }
+
+    if (bytes > SIZE_MAX - (page - 1))
+    {
+        return 0;
+    }
+
+    return (bytes + page - 1) & ~(page - 1);
+}
+
+/*
+ * Reads the online nodes from sysfs (e.g. "0-3,6").
+ * Returns the number of nodes found, 0 if the host does not expose NUMA information.
+ */
+static size_t read_online_nodes(unsigned long* mask)
+{
+    memset(mask, 0, NODE_MASK_WORDS * sizeof(unsigned long));
+
+    FILE* file = fopen("/sys/devices/system/node/online", "r");
+
+    if (!file)
+    {
+        return 0;
+    }
+
+    size_t count = 0;
+    unsigned first, last;
+    int separator;
+
+    while (fscanf(file, "%u", &first) == 1)
+    {
+        last = first;
+        separator = fgetc(file);
+
+        if (separator == '-')
+        {
+            if (fscanf(file, "%u", &last) != 1)
+            {
+                break;
+            }
+            separator = fgetc(file);
+        }
+
+        for (unsigned node = first; (node <= last) && (node < MAX_NUMA_NODES); ++node)
+        {
+            mask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+            count++;
+        }
+
+        if (separator != ',')
+        {
+            break;
+        }
+    }
+
+    fclose(file);
+    return count;
+}
+
+static void apply_numa_policy(void* buffer, const size_t bytes, const large_buffer_options* options)
+{
+    if (options->numa_policy == LARGE_BUFFER_NUMA_DEFAULT)
+    {
+        return;
+    }
+
+    unsigned long online[NODE_MASK_WORDS];
+
+    /* Nothing to place on single-node hosts */
+    if (read_online_nodes(online) <= 1)
+    {
+        return;
+    }
+
+    unsigned long nodes[NODE_MASK_WORDS] = {0};
+    int mode;
+
+    if (options->numa_policy == LARGE_BUFFER_NUMA_INTERLEAVE)
+    {
+        memcpy(nodes, online, sizeof(nodes));
+        mode = MPOL_INTERLEAVE;
+    }
+    else
+    {
+        const int node = options->numa_node;
+        const size_t bits = 8 * sizeof(unsigned long);
+
+        if ((node < 0) || (node >= MAX_NUMA_NODES) || !(online[node / bits] & (1UL << (node % bits))))
+        {
+            return;
+        }
+
+        nodes[node / bits] = 1UL << (node % bits);
+        mode = MPOL_BIND;
+    }
+
+    /* A failing mbind leaves the default policy in place, which is still a usable buffer */
+    syscall(SYS_mbind, buffer, bytes, mode, nodes, (unsigned long)MAX_NUMA_NODES, 0U);
+}
+
+static void apply_hints(void* buffer, const size_t bytes, const large_buffer_options* options)
+{
+#ifdef MADV_HUGEPAGE
+    if (options->huge_pages)
+    {
+        madvise(buffer, bytes, MADV_HUGEPAGE);
+    }
+#endif
+
+    apply_numa_policy(buffer, bytes, options);
+}
+
+static void* touch_pages(void* arg)
+{
+    const touch_range* range = arg;
+
+    for (volatile unsigned char* page = range->start; page < range->end; page += range->page_size)
+    {
+        *page = 0;
+    }
+
+    return nullptr;
+}
+
+/* Faults [start, start + bytes) in from several threads so each one places its share of pages */
+static void first_touch(unsigned char* start, const size_t bytes, const size_t threads)
+{
+    if ((threads == 0) || (bytes == 0))
+    {
+        return;
+    }
+
+    const size_t page = page_size();
+    const size_t pages = (bytes + page - 1) / page;
+    const size_t workers = threads < pages ? threads : pages;
+
+    pthread_t* ids = calloc(workers, sizeof(pthread_t));
+    touch_range* ranges = calloc(workers, sizeof(touch_range));
+    bool* started = calloc(workers, sizeof(bool));
+
+    if (!ids || !ranges || !started)
+    {
+        free(ids);
+        free(ranges);
+        free(started);
+        touch_range all = {start, start + bytes, page};
+        touch_pages(&all);
+        return;
+    }
+
+    for (size_t i = 0; i < workers; ++i)
+    {
+        ranges[i].start = start + ((pages * i / workers) * page);
+        ranges[i].end = start + ((pages * (i + 1) / workers) * page);
+        ranges[i].page_size = page;
+
+        if (ranges[i].end > start + bytes)
+        {
+            ranges[i].end = start + bytes;
+        }
+    }
+
+    /* The calling thread takes the first range, and any range whose thread could not be started */
+    for (size_t i = 1; i < workers; ++i)
+    {
+        started[i] = pthread_create(&ids[i], nullptr, touch_pages, &ranges[i]) == 0;
+    }
+
+    for (size_t i = 0; i < workers; ++i)
+    {
+        if (!started[i])
+        {
+            touch_pages(&ranges[i]);
+        }
+    }
+
+    for (size_t i = 1; i < workers; ++i)
+    {
+        if (started[i])
+        {
+            pthread_join(ids[i], nullptr);
+        }
+    }
+
+    free(started);
+    free(ids);
+    free(ranges);
+}
+
+void* large_buffer_map(const size_t bytes, const large_buffer_options* options)
+{
+    const large_buffer_options defaults = {.huge_pages = true};
+
+    if (!options)
+    {
+        options = &defaults;
+    }
+
+    const size_t length = round_to_pages(bytes);
+
+    if (length == 0)
+    {
+        return nullptr;
+    }
+
+    /* Huge pages need a 2 MiB aligned start, so map a little more and trim the excess */
+    const bool align = options->huge_pages && (length >= HUGE_PAGE_SIZE) && (length <= SIZE_MAX - HUGE_PAGE_SIZE);
+    const size_t mapped_length = align ? length + HUGE_PAGE_SIZE : length;
+
+    unsigned char* mapping = mmap(nullptr, mapped_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (mapping == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    unsigned char* buffer = mapping;
+
+    if (align)
+    {
+        buffer = (unsigned char*)(((uintptr_t)mapping + HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(HUGE_PAGE_SIZE - 1));
+
+        if (buffer > mapping)
+        {
+            munmap(mapping, (size_t)(buffer - mapping));
+        }
+
+        const size_t tail = (size_t)((mapping + mapped_length) - (buffer + length));
+
+        if (tail > 0)
+        {
+            munmap(buffer + length, tail);
+        }
+    }
+
+    apply_hints(buffer, length, options);
+    first_touch(buffer, length, options->first_touch_threads);
+
+    return buffer;
+}
+
+void* large_buffer_remap(void* buffer, const size_t old_bytes, const size_t new_bytes,
+                         const large_buffer_options* options)
+{
+    const large_buffer_options defaults = {.huge_pages = true};
+
+    if (!options)
+    {
+        options = &defaults;
+    }
+
+    const size_t old_length = round_to_pages(old_bytes);
+    const size_t new_length = round_to_pages(new_bytes);
+
+    if ((!buffer) || (old_length == 0) || (new_length == 0))
+    {
+        return nullptr;
+    }
+
+    if (old_length == new_length)
+    {
+        return buffer;
+    }
+
+    unsigned char* remapped = mremap(buffer, old_length, new_length, MREMAP_MAYMOVE);
+
+    if (remapped == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    if (new_length > old_length)
+    {
+        apply_hints(remapped, new_length, options);
+        first_touch(remapped + old_length, new_length - old_length, options->first_touch_threads);
+    }
+
+    return remapped;
+}
+
+void large_buffer_unmap(void* buffer, const size_t bytes)
+{
+    const size_t length = round_to_pages(bytes);
+
+    if ((!buffer) || (length == 0))
+    {
+        return;
+    }
+
+    munmap(buffer, length);
+}
+
+#else
+
+/* Without mmap the buffers fall back to the C allocator */
+
+void* large_buffer_map(const size_t bytes, const large_buffer_options* options)
+{
+    (void)options;
+    return calloc(1, bytes ? bytes : 1);
+}
+
+void* large_buffer_remap(void* buffer, const size_t old_bytes, const size_t new_bytes,
+                         const large_buffer_options* options)
+{
+    (void)options;
+
+    unsigned char* resized = realloc(buffer, new_bytes ? new_bytes : 1);
+
+    if (resized && (new_bytes > old_bytes))
+    {
+        memset(resized + old_bytes, 0, new_bytes - old_bytes);
+    }
+
+    return resized;
+}
+
+void large_buffer_unmap(void* buffer, const size_t bytes)
+{
+    (void)bytes;
+    free(buffer);
+}
+
+#endif
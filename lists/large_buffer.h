@@ -0,0 +1,70 @@
+/**************************************************************************
+ *   large_buffer.h  --  This file is part of Data Structures Library.    *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#ifndef _DATASTRUCTURES_LARGE_BUFFER_H
+#define _DATASTRUCTURES_LARGE_BUFFER_H
+
+#include <stddef.h>
+
+/* NUMA placement of a large buffer. */
+typedef enum large_buffer_numa_policy
+{
+    /* Pages are placed on the node of the thread that first touches them */
+    LARGE_BUFFER_NUMA_DEFAULT,
+    /* Pages are interleaved across all online nodes */
+    LARGE_BUFFER_NUMA_INTERLEAVE,
+    /* Pages are bound to a single node */
+    LARGE_BUFFER_NUMA_BIND
+} large_buffer_numa_policy;
+
+/* Options for buffers mapped directly from the kernel. */
+typedef struct large_buffer_options
+{
+    /* Requests transparent huge pages for the buffer */
+    bool huge_pages;
+    /* The NUMA placement of the buffer, ignored on single-node hosts */
+    large_buffer_numa_policy numa_policy;
+    /* The node used by LARGE_BUFFER_NUMA_BIND */
+    int numa_node;
+    /* The number of threads that fault the buffer in up front, 0 to fault it lazily on first use */
+    size_t first_touch_threads;
+} large_buffer_options;
+
+/**
+ * Maps a zeroed buffer of at least @bytes bytes.
+ * Pages are zeroed by the kernel when first touched, no eager zeroing takes place.
+ * Huge page and NUMA hints that the host does not support are silently skipped.
+ * @param bytes The size of the buffer in bytes.
+ * @param options The placement options, nullptr for the defaults.
+ * @returns a pointer to the buffer, or nullptr on failure. */
+void* large_buffer_map(const size_t bytes, const large_buffer_options* options);
+
+/**
+ * Resizes a buffer returned by large_buffer_map(), moving it if needed without copying pages.
+ * The contents up to the smaller of both sizes are preserved, and grown parts are zeroed.
+ * @param buffer The buffer to resize.
+ * @param old_bytes The size the buffer was mapped or last resized with.
+ * @param new_bytes The new size of the buffer in bytes.
+ * @param options The options the buffer was mapped with.
+ * @returns a pointer to the resized buffer, or nullptr on failure (the old buffer stays valid). */
+void* large_buffer_remap(void* buffer, const size_t old_bytes, const size_t new_bytes,
+                         const large_buffer_options* options);
+
+/**
+ * Unmaps a buffer returned by large_buffer_map() or large_buffer_remap().
+ * @param buffer The buffer to unmap.
+ * @param bytes The size the buffer was mapped or last resized with. */
+void large_buffer_unmap(void* buffer, const size_t bytes);
+
+#endif //_DATASTRUCTURES_LARGE_BUFFER_H
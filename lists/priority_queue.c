@@ -0,0 +1,519 @@
+/**************************************************************************
+ *   priority_queue.c  --                                                 *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#include "priority_queue.h"
+
+/* Marks a handle that is not in the queue */
+#define PQUEUE_NO_POSITION SIZE_MAX
+
+/* Structure type. */
+typedef struct PRIORITY_QUEUE
+{
+    /* The heap, each element followed by its handle when handles are tracked */
+    dynamic_array* heap;
+    /* The heap index of every handle, nullptr when handles are not tracked */
+    dynamic_array* positions;
+    /* Handles released by pop and remove, reused before new ones */
+    dynamic_array* free_handles;
+    /* The comparison function, the lowest element is the root */
+    int (*compar)(const void*, const void*);
+    /* The number of children per node */
+    size_t arity;
+    /* The size of a single data element in bytes */
+    size_t data_size;
+    /* The size of a heap entry in bytes, the data and its handle */
+    size_t element_size;
+    /* Holds the element being sifted */
+    void* scratch;
+#ifdef DS_STATS
+    /* The operation counters of the queue */
+    ds_atomic_stats stats;
+#endif
+} priority_queue;
+
+
+static bool pqueue_less(const priority_queue* queue, const void* a, const void* b)
+{
+    DS_STATS_COUNT(queue, comparisons, 1);
+    return queue->compar(a, b) < 0;
+}
+
+/* The heap array is private and never snapshotted, so writing through its data pointer is safe */
+static unsigned char* pqueue_base(const priority_queue* queue)
+{
+    return dynarr_get_at(queue->heap, 0);
+}
+
+static size_t* pqueue_positions(const priority_queue* queue)
+{
+    return queue->positions ? dynarr_get_at(queue->positions, 0) : nullptr;
+}
+
+/* Writes an element at a heap index and records the new position of its handle */
+static void pqueue_place(const priority_queue* queue, unsigned char* base, size_t* positions, const size_t index,
+                         const void* element)
+{
+    unsigned char* slot = base + (index * queue->element_size);
+    memcpy(slot, element, queue->element_size);
+
+    if (positions)
+    {
+        size_t handle;
+        memcpy(&handle, slot + queue->data_size, sizeof(size_t));
+        positions[handle] = index;
+    }
+}
+
+/* Moves the element at index up past every parent that compares higher, shifting the parents down */
+static void pqueue_sift_up(priority_queue* queue, size_t index)
+{
+    unsigned char* base = pqueue_base(queue);
+    size_t* positions = pqueue_positions(queue);
+    const size_t element_size = queue->element_size;
+
+    memcpy(queue->scratch, base + (index * element_size), element_size);
+
+    while (index > 0)
+    {
+        const size_t parent = (index - 1) / queue->arity;
+        const unsigned char* parent_element = base + (parent * element_size);
+        if (!pqueue_less(queue, queue->scratch, parent_element))
+        {
+            break;
+        }
+        pqueue_place(queue, base, positions, index, parent_element);
+        index = parent;
+    }
+
+    pqueue_place(queue, base, positions, index, queue->scratch);
+}
+
+/* Moves the element at index down past every lowest child that compares lower, shifting the children up */
+static void pqueue_sift_down(priority_queue* queue, size_t index)
+{
+    const size_t size = dynarr_size(queue->heap);
+
+    if (size < 2)
+    {
+        return;
+    }
+
+    unsigned char* base = pqueue_base(queue);
+    size_t* positions = pqueue_positions(queue);
+    const size_t element_size = queue->element_size;
+
+    memcpy(queue->scratch, base + (index * element_size), element_size);
+
+    /* The first child d * index + 1 exists while index <= (size - 2) / d */
+    while (index <= (size - 2) / queue->arity)
+    {
+        const size_t first = (index * queue->arity) + 1;
+        const size_t last = (size - first < queue->arity) ? size : first + queue->arity;
+
+        size_t lowest = first;
+        for (size_t child = first + 1; child < last; ++child)
+        {
+            if (pqueue_less(queue, base + (child * element_size), base + (lowest * element_size)))
+            {
+                lowest = child;
+            }
+        }
+
+        const unsigned char* lowest_element = base + (lowest * element_size);
+        if (!pqueue_less(queue, lowest_element, queue->scratch))
+        {
+            break;
+        }
+        pqueue_place(queue, base, positions, index, lowest_element);
+        index = lowest;
+    }
+
+    pqueue_place(queue, base, positions, index, queue->scratch);
+}
+
+/* Floyd's construction, sifting down every parent from the last one */
+static void pqueue_heapify(priority_queue* queue)
+{
+    const size_t size = dynarr_size(queue->heap);
+
+    if (size < 2)
+    {
+        return;
+    }
+
+    for (size_t i = ((size - 2) / queue->arity) + 1; i > 0; --i)
+    {
+        pqueue_sift_down(queue, i - 1);
+    }
+}
+
+static bool pqueue_acquire_handle(priority_queue* queue, size_t* handle)
+{
+    const size_t free_count = dynarr_size(queue->free_handles);
+
+    if (free_count > 0)
+    {
+        return dynarr_remove_at(queue->free_handles, free_count - 1, handle, sizeof(size_t));
+    }
+
+    const size_t none = PQUEUE_NO_POSITION;
+    *handle = dynarr_size(queue->positions);
+    return dynarr_add(queue->positions, &none, sizeof(size_t));
+}
+
+static void pqueue_release_handle(priority_queue* queue, const size_t handle)
+{
+    pqueue_positions(queue)[handle] = PQUEUE_NO_POSITION;
+
+    /* A handle that cannot be recorded as free is simply never reused */
+    dynarr_add(queue->free_handles, &handle, sizeof(size_t));
+}
+
+static priority_queue* pqueue_allocate(const size_t data_size, const size_t arity,
+                                       int (*compar)(const void*, const void*), const bool handles)
+{
+    if ((data_size == 0) || (arity == 1) || (!compar) || (handles && (data_size > SIZE_MAX - sizeof(size_t))))
+    {
+        return nullptr;
+    }
+
+    priority_queue* queue = calloc(1, sizeof(priority_queue));
+
+    if (!queue)
+    {
+        return nullptr;
+    }
+
+    queue->compar = compar;
+    queue->arity = arity ? arity : PQUEUE_DEFAULT_ARITY;
+    queue->data_size = data_size;
+    queue->element_size = handles ? data_size + sizeof(size_t) : data_size;
+    queue->scratch = malloc(queue->element_size);
+    queue->heap = dynarr_initialize_empty(queue->element_size);
+
+    if (handles)
+    {
+        queue->positions = dynarr_initialize_empty(sizeof(size_t));
+        queue->free_handles = dynarr_initialize_empty(sizeof(size_t));
+    }
+
+    if ((!queue->scratch) || (!queue->heap) || (handles && ((!queue->positions) || (!queue->free_handles))))
+    {
+        pqueue_destroy(queue);
+        return nullptr;
+    }
+
+    DS_STATS_COUNT(queue, allocations, 1);
+    return queue;
+}
+
+priority_queue* pqueue_initialize(const size_t data_size, const size_t arity, int (*compar)(const void*, const void*))
+{
+    return pqueue_allocate(data_size, arity, compar, false);
+}
+
+priority_queue* pqueue_initialize_with_handles(const size_t data_size, const size_t arity,
+                                               int (*compar)(const void*, const void*))
+{
+    return pqueue_allocate(data_size, arity, compar, true);
+}
+
+priority_queue* pqueue_initialize_from(const dynamic_array* list, const size_t data_size, const size_t arity,
+                                       int (*compar)(const void*, const void*))
+{
+    if (!list)
+    {
+        return nullptr;
+    }
+
+    priority_queue* queue = pqueue_allocate(data_size, arity, compar, false);
+
+    if (!queue)
+    {
+        return nullptr;
+    }
+
+    dynamic_array* heap = dynarr_initialize_from(list, data_size);
+
+    if (!heap)
+    {
+        pqueue_destroy(queue);
+        return nullptr;
+    }
+
+    dynarr_destroy(queue->heap);
+    queue->heap = heap;
+    pqueue_heapify(queue);
+
+    return queue;
+}
+
+void pqueue_destroy(priority_queue* queue)
+{
+    if (!queue)
+    {
+        return;
+    }
+
+    dynarr_destroy(queue->heap);
+    dynarr_destroy(queue->positions);
+    dynarr_destroy(queue->free_handles);
+    free(queue->scratch);
+    free(queue);
+}
+
+bool pqueue_push(priority_queue* queue, const void* data, const size_t data_size)
+{
+    if ((!queue || !data) || (queue->data_size != data_size))
+    {
+        return false;
+    }
+
+    if (queue->positions)
+    {
+        size_t handle;
+        return pqueue_push_handle(queue, data, data_size, &handle);
+    }
+
+    if (!dynarr_add(queue->heap, data, data_size))
+    {
+        return false;
+    }
+
+    pqueue_sift_up(queue, dynarr_size(queue->heap) - 1);
+    return true;
+}
+
+bool pqueue_push_all(priority_queue* queue, const dynamic_array* list)
+{
+    if ((!queue || !list) || (queue->positions))
+    {
+        return false;
+    }
+
+    const size_t old_size = dynarr_size(queue->heap);
+    const size_t count = dynarr_size(list);
+    bool ok = true;
+
+    for (size_t i = 0; (i < count) && ok; ++i)
+    {
+        ok = dynarr_get(list, i, queue->scratch, queue->data_size) &&
+            dynarr_add(queue->heap, queue->scratch, queue->data_size);
+    }
+
+    /* Whatever was appended is ordered again, even when the batch stopped early */
+    const size_t new_size = dynarr_size(queue->heap);
+    if (new_size - old_size >= old_size)
+    {
+        pqueue_heapify(queue);
+    }
+    else
+    {
+        for (size_t i = old_size; i < new_size; ++i)
+        {
+            pqueue_sift_up(queue, i);
+        }
+    }
+
+    return ok;
+}
+
+bool pqueue_pop(priority_queue* queue, void* out_data, const size_t data_size)
+{
+    if ((!queue || !out_data) || (queue->data_size != data_size) || (dynarr_is_empty(queue->heap)))
+    {
+        return false;
+    }
+
+    const unsigned char* root = pqueue_base(queue);
+    memcpy(out_data, root, data_size);
+
+    size_t root_handle = PQUEUE_NO_POSITION;
+    if (queue->positions)
+    {
+        memcpy(&root_handle, root + data_size, sizeof(size_t));
+    }
+
+    /* The last element fills the root and sinks into place */
+    const size_t last = dynarr_size(queue->heap) - 1;
+    dynarr_remove_at(queue->heap, last, queue->scratch, queue->element_size);
+
+    if (last > 0)
+    {
+        pqueue_place(queue, pqueue_base(queue), pqueue_positions(queue), 0, queue->scratch);
+        pqueue_sift_down(queue, 0);
+    }
+
+    if (queue->positions)
+    {
+        pqueue_release_handle(queue, root_handle);
+    }
+
+    return true;
+}
+
+bool pqueue_peek(const priority_queue* queue, void* out_data, const size_t data_size)
+{
+    if ((!queue || !out_data) || (queue->data_size != data_size) || (dynarr_is_empty(queue->heap)))
+    {
+        return false;
+    }
+
+    memcpy(out_data, dynarr_data(queue->heap), data_size);
+    return true;
+}
+
+bool pqueue_push_handle(priority_queue* queue, const void* data, const size_t data_size, size_t* out_handle)
+{
+    if ((!queue || !data || !out_handle) || (!queue->positions) || (queue->data_size != data_size))
+    {
+        return false;
+    }
+
+    size_t handle;
+    if (!pqueue_acquire_handle(queue, &handle))
+    {
+        return false;
+    }
+
+    memcpy(queue->scratch, data, data_size);
+    memcpy((unsigned char*)(queue->scratch) + data_size, &handle, sizeof(size_t));
+
+    if (!dynarr_add(queue->heap, queue->scratch, queue->element_size))
+    {
+        pqueue_release_handle(queue, handle);
+        return false;
+    }
+
+    pqueue_sift_up(queue, dynarr_size(queue->heap) - 1);
+    *out_handle = handle;
+    return true;
+}
+
+bool pqueue_contains_handle(const priority_queue* queue, const size_t handle)
+{
+    if ((!queue) || (!queue->positions) || (handle >= dynarr_size(queue->positions)))
+    {
+        return false;
+    }
+
+    return ((const size_t*)dynarr_data(queue->positions))[handle] != PQUEUE_NO_POSITION;
+}
+
+bool pqueue_update(priority_queue* queue, const size_t handle, const void* data, const size_t data_size)
+{
+    if ((!data) || (!pqueue_contains_handle(queue, handle)) || (queue->data_size != data_size))
+    {
+        return false;
+    }
+
+    const size_t index = pqueue_positions(queue)[handle];
+    unsigned char* element = pqueue_base(queue) + (index * queue->element_size);
+
+    const int order = queue->compar(data, element);
+    DS_STATS_COUNT(queue, comparisons, 1);
+    memcpy(element, data, data_size);
+
+    if (order < 0)
+    {
+        pqueue_sift_up(queue, index);
+    }
+    else if (order > 0)
+    {
+        pqueue_sift_down(queue, index);
+    }
+
+    return true;
+}
+
+bool pqueue_remove(priority_queue* queue, const size_t handle, void* out_data, const size_t data_size)
+{
+    if ((!out_data) || (!pqueue_contains_handle(queue, handle)) || (queue->data_size != data_size))
+    {
+        return false;
+    }
+
+    const size_t index = pqueue_positions(queue)[handle];
+    memcpy(out_data, pqueue_base(queue) + (index * queue->element_size), data_size);
+
+    /* The last element fills the gap and moves whichever way its priority requires */
+    const size_t last = dynarr_size(queue->heap) - 1;
+    dynarr_remove_at(queue->heap, last, queue->scratch, queue->element_size);
+
+    if (index != last)
+    {
+        pqueue_place(queue, pqueue_base(queue), pqueue_positions(queue), index, queue->scratch);
+        if (pqueue_less(queue, queue->scratch, out_data))
+        {
+            pqueue_sift_up(queue, index);
+        }
+        else
+        {
+            pqueue_sift_down(queue, index);
+        }
+    }
+
+    pqueue_release_handle(queue, handle);
+    return true;
+}
+
+void pqueue_clear(priority_queue* queue)
+{
+    if (!queue)
+    {
+        return;
+    }
+
+    dynarr_clear(queue->heap);
+    dynarr_clear(queue->positions);
+    dynarr_clear(queue->free_handles);
+}
+
+size_t pqueue_size(const priority_queue* queue)
+{
+    if (!queue)
+    {
+        return 0;
+    }
+
+    return dynarr_size(queue->heap);
+}
+
+bool pqueue_is_empty(const priority_queue* queue)
+{
+    return pqueue_size(queue) == 0;
+}
+
+bool pqueue_get_stats(const priority_queue* queue, ds_stats* out_stats)
+{
+    if (!out_stats)
+    {
+        return false;
+    }
+
+#ifdef DS_STATS
+    if (!queue)
+    {
+        return false;
+    }
+
+    ds_stats_load(&queue->stats, out_stats);
+    return true;
+#else
+    (void)queue;
+    memset(out_stats, 0, sizeof(ds_stats));
+    return false;
+#endif
+}
@@ -0,0 +1,134 @@
+/**************************************************************************
+ *   priority_queue.h  --                                                 *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#ifndef _DATASTRUCTURES_PRIORITY_QUEUE_H
+#define _DATASTRUCTURES_PRIORITY_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "dynamic_array.h"
+#include "ds_stats.h"
+
+/*
+ * A priority queue kept as a d-ary heap in a dynamic array.
+ * The children of element i are the d elements starting at d * i + 1, so they are adjacent in memory
+ * and a 4 or 8-ary heap reads one or two cache lines per level, with half or a third of a binary heap's depth.
+ * The element that compares lowest is served first.
+ */
+
+/* The number of children per node used when none is given */
+#ifndef PQUEUE_DEFAULT_ARITY
+#define PQUEUE_DEFAULT_ARITY 4
+#endif
+
+/* Structure type. */
+typedef struct PRIORITY_QUEUE priority_queue;
+
+/**
+ * Initializes an empty priority queue.
+ * @param data_size The size of the data type to be stored in the queue (in bytes).
+ * @param arity The number of children per node, at least 2, or 0 for PQUEUE_DEFAULT_ARITY.
+ * @param compar The comparison function, as for qsort(); the lowest element is served first.
+ * @returns a pointer to the priority queue initialized. */
+priority_queue* pqueue_initialize(const size_t data_size, const size_t arity, int (*compar)(const void*, const void*));
+
+/**
+ * Initializes an empty priority queue whose elements can be found again through handles,
+ * to change their priority or remove them. See pqueue_push_handle().
+ * @param data_size The size of the data type to be stored in the queue (in bytes).
+ * @param arity The number of children per node, at least 2, or 0 for PQUEUE_DEFAULT_ARITY.
+ * @param compar The comparison function, as for qsort(); the lowest element is served first.
+ * @returns a pointer to the priority queue initialized. */
+priority_queue* pqueue_initialize_with_handles(const size_t data_size, const size_t arity,
+                                               int (*compar)(const void*, const void*));
+
+/**
+ * Initializes a priority queue holding the elements of a dynamic array, heapified in O(n).
+ * @param list The dynamic array to copy.
+ * @param data_size The size of the data type stored in the list (in bytes).
+ * @param arity The number of children per node, at least 2, or 0 for PQUEUE_DEFAULT_ARITY.
+ * @param compar The comparison function, as for qsort(); the lowest element is served first.
+ * @returns a pointer to the priority queue initialized. */
+priority_queue* pqueue_initialize_from(const dynamic_array* list, const size_t data_size, const size_t arity,
+                                       int (*compar)(const void*, const void*));
+
+/**
+ * Destroys a priority queue and frees the allocated memory.
+ * @param queue The priority queue to be destroyed. */
+void pqueue_destroy(priority_queue* queue);
+
+
+bool pqueue_push(priority_queue* queue, const void* data, const size_t data_size);
+
+/**
+ * Adds every element of a dynamic array. A batch at least as large as the queue
+ * rebuilds the heap in O(n) instead of sifting each element up.
+ * Queues with handles do not accept batches, since the handles could not be returned.
+ * @param queue The priority queue.
+ * @param list The elements to add.
+ * @returns true if every element was added, false otherwise. */
+bool pqueue_push_all(priority_queue* queue, const dynamic_array* list);
+
+bool pqueue_pop(priority_queue* queue, void* out_data, const size_t data_size);
+bool pqueue_peek(const priority_queue* queue, void* out_data, const size_t data_size);
+
+
+/**
+ * Adds an element to a queue initialized with handles.
+ * @param queue The priority queue.
+ * @param data The element to add.
+ * @param data_size The size of the element (in bytes).
+ * @param out_handle Receives the element's handle, valid until it is popped or removed.
+ * @returns true if the element was added, false otherwise. */
+bool pqueue_push_handle(priority_queue* queue, const void* data, const size_t data_size, size_t* out_handle);
+
+/**
+ * Replaces an element found by its handle, moving it up on a decrease-key or down on an increase.
+ * @param queue The priority queue.
+ * @param handle The element's handle.
+ * @param data The new element.
+ * @param data_size The size of the element (in bytes).
+ * @returns true if the element was replaced, false if the handle is not in the queue. */
+bool pqueue_update(priority_queue* queue, const size_t handle, const void* data, const size_t data_size);
+
+/**
+ * Removes an element found by its handle.
+ * @param queue The priority queue.
+ * @param handle The element's handle.
+ * @param out_data Receives the element.
+ * @param data_size The size of the element (in bytes).
+ * @returns true if the element was removed, false if the handle is not in the queue. */
+bool pqueue_remove(priority_queue* queue, const size_t handle, void* out_data, const size_t data_size);
+
+bool pqueue_contains_handle(const priority_queue* queue, const size_t handle);
+
+
+void pqueue_clear(priority_queue* queue);
+size_t pqueue_size(const priority_queue* queue);
+bool pqueue_is_empty(const priority_queue* queue);
+
+
+/**
+ * Reads the operation counters of a priority queue.
+ * @param queue The priority queue.
+ * @param out_stats Receives the counters, zeroed when statistics are disabled.
+ * @returns true if the library was built with DS_STATS. */
+bool pqueue_get_stats(const priority_queue* queue, ds_stats* out_stats);
+
+#endif //_DATASTRUCTURES_PRIORITY_QUEUE_H
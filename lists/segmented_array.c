@@ -0,0 +1,484 @@
+/**************************************************************************
+ *   segmented_array.c  --                                                *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#include "segmented_array.h"
+
+static_assert((SEGARR_FIRST_BLOCK_CAPACITY & (SEGARR_FIRST_BLOCK_CAPACITY - 1)) == 0,
+              "SEGARR_FIRST_BLOCK_CAPACITY must be a power of two");
+
+/* The most blocks a directory can hold, enough to address every size_t index */
+#define SEGARR_MAX_BLOCKS (sizeof(size_t) * 8)
+
+/* Structure type. */
+typedef struct SEGMENTED_ARRAY
+{
+    /* Block k holds SEGARR_FIRST_BLOCK_CAPACITY << k elements */
+    void* blocks[SEGARR_MAX_BLOCKS];
+    /* The number of blocks allocated */
+    size_t block_count;
+    /* The number of elements in the list */
+    size_t size;
+    /* The size of a single data element in bytes */
+    size_t data_size;
+    /* The number of elements the allocated blocks can hold */
+    size_t capacity;
+#ifdef DS_STATS
+    /* The operation counters of the list */
+    ds_atomic_stats stats;
+#endif
+} segmented_array;
+
+
+static size_t floor_log2(const size_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (sizeof(unsigned long long) * 8 - 1) - (size_t)__builtin_clzll(value);
+#else
+    size_t res = 0;
+    size_t rest = value;
+    while (rest >>= 1)
+    {
+        res++;
+    }
+    return res;
+#endif
+}
+
+static size_t block_capacity(const size_t block)
+{
+    return (size_t)SEGARR_FIRST_BLOCK_CAPACITY << block;
+}
+
+/*
+ * Finds the block and the offset of an element.
+ * Shifting the index by the first block's capacity makes the block the position of its highest bit.
+ */
+static void segarr_locate(const size_t index, size_t* block, size_t* offset)
+{
+    const size_t position = index + SEGARR_FIRST_BLOCK_CAPACITY;
+    *block = floor_log2(position) - floor_log2(SEGARR_FIRST_BLOCK_CAPACITY);
+    *offset = position - block_capacity(*block);
+}
+
+static unsigned char* segarr_element(const segmented_array* list, const size_t index)
+{
+    size_t block, offset;
+    segarr_locate(index, &block, &offset);
+    return (unsigned char*)(list->blocks[block]) + (offset * list->data_size);
+}
+
+static bool segarr_add_block(segmented_array* list)
+{
+    const size_t block = list->block_count;
+
+    /* First condition checks if the directory is full, the others if the block or the capacity overflow size_t */
+    if ((block >= SEGARR_MAX_BLOCKS - floor_log2(SEGARR_FIRST_BLOCK_CAPACITY) - 1) ||
+        (block_capacity(block) > SIZE_MAX / list->data_size) ||
+        (list->capacity > SIZE_MAX - SEGARR_FIRST_BLOCK_CAPACITY - block_capacity(block)))
+    {
+        return false;
+    }
+
+    /* Elements are always written before being read, so the block is not zeroed */
+    void* data = malloc(block_capacity(block) * list->data_size);
+
+    if (!data)
+    {
+        return false;
+    }
+
+    list->blocks[block] = data;
+    list->block_count++;
+    list->capacity += block_capacity(block);
+    DS_STATS_COUNT(list, allocations, 1);
+    DS_STATS_PEAK(list, list->capacity);
+    return true;
+}
+
+segmented_array* segarr_initialize(const size_t data_size)
+{
+    if (data_size == 0)
+    {
+        return nullptr;
+    }
+
+    segmented_array* list = calloc(1, sizeof(segmented_array));
+
+    if (!list)
+    {
+        return nullptr;
+    }
+
+    list->data_size = data_size;
+    DS_STATS_COUNT(list, allocations, 1);
+    return list;
+}
+
+void segarr_destroy(segmented_array* list)
+{
+    if (!list)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < list->block_count; ++i)
+    {
+        free(list->blocks[i]);
+    }
+
+    free(list);
+}
+
+bool segarr_get(const segmented_array* list, const size_t index, void* out_data, const size_t data_size)
+{
+    if ((!list) || (index >= list->size) || (list->data_size != data_size) || !out_data)
+    {
+        return false;
+    }
+
+    memcpy(out_data, segarr_element(list, index), data_size);
+    DS_STATS_COUNT(list, bytes_copied, data_size);
+    return true;
+}
+
+void* segarr_get_at(const segmented_array* list, const size_t index)
+{
+    if ((!list) || (index >= list->size))
+    {
+        return nullptr;
+    }
+
+    return segarr_element(list, index);
+}
+
+bool segarr_add(segmented_array* list, const void* data, const size_t data_size)
+{
+    if ((!list || !data) || (list->data_size != data_size))
+    {
+        return false;
+    }
+
+    if ((list->size == list->capacity) && !segarr_add_block(list))
+    {
+        return false;
+    }
+
+    memcpy(segarr_element(list, list->size), data, data_size);
+    DS_STATS_COUNT(list, bytes_copied, data_size);
+    list->size++;
+    return true;
+}
+
+bool segarr_set(segmented_array* list, const size_t index, const void* data, const size_t data_size)
+{
+    if ((!list || !data) || (index >= list->size) || (list->data_size != data_size))
+    {
+        return false;
+    }
+
+    memcpy(segarr_element(list, index), data, data_size);
+    DS_STATS_COUNT(list, bytes_copied, data_size);
+    return true;
+}
+
+bool segarr_remove_at(segmented_array* list, const size_t index, void* out_data, const size_t data_size)
+{
+    if ((!list) || (index >= list->size) || (list->data_size != data_size) || (!out_data))
+    {
+        return false;
+    }
+
+    memcpy(out_data, segarr_element(list, index), data_size);
+    DS_STATS_COUNT(list, bytes_copied, data_size);
+
+    /* Shifts the following elements left one block at a time, carrying each block's first element back */
+    size_t block, offset;
+    segarr_locate(index, &block, &offset);
+    size_t block_start = index - offset;
+
+    while (block_start + offset < list->size - 1)
+    {
+        unsigned char* data = list->blocks[block];
+        const size_t block_end = block_start + block_capacity(block);
+        const size_t last = (block_end < list->size ? block_end : list->size) - block_start - 1;
+
+        memmove(data + (offset * data_size), data + ((offset + 1) * data_size), (last - offset) * data_size);
+        DS_STATS_COUNT(list, bytes_moved, (last - offset) * data_size);
+
+        if (block_end >= list->size)
+        {
+            break;
+        }
+
+        memcpy(data + (last * data_size), list->blocks[block + 1], data_size);
+        DS_STATS_COUNT(list, bytes_moved, data_size);
+
+        block_start = block_end;
+        block++;
+        offset = 0;
+    }
+
+    list->size--;
+    return true;
+}
+
+bool segarr_contains(const segmented_array* list, const void* data, const size_t data_size)
+{
+    size_t index;
+    return segarr_index_of(list, data, data_size, &index);
+}
+
+bool segarr_index_of(const segmented_array* list, const void* data, const size_t data_size, size_t* index)
+{
+    if ((!list || !data || !index) || (list->data_size != data_size))
+    {
+        return false;
+    }
+
+    size_t block_start = 0;
+
+    for (size_t block = 0; (block < list->block_count) && (block_start < list->size); ++block)
+    {
+        const unsigned char* elements = list->blocks[block];
+        const size_t count = (list->size - block_start < block_capacity(block))
+                                 ? list->size - block_start
+                                 : block_capacity(block);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!memcmp(data, elements + (i * data_size), data_size))
+            {
+                DS_STATS_COUNT(list, comparisons, block_start + i + 1);
+                *index = block_start + i;
+                return true;
+            }
+        }
+
+        block_start += count;
+    }
+
+    DS_STATS_COUNT(list, comparisons, list->size);
+    return false;
+}
+
+// Note: If the list stores pointers they should be freed individually before calling segarr_clear()
+// As that would cause a memory leak.
+void segarr_clear(segmented_array* list)
+{
+    if (!list)
+    {
+        return;
+    }
+
+    list->size = 0;
+}
+
+size_t segarr_size(const segmented_array* list)
+{
+    if (!list)
+    {
+        return 0;
+    }
+
+    return list->size;
+}
+
+bool segarr_is_empty(const segmented_array* list)
+{
+    if (!list)
+    {
+        return true;
+    }
+
+    return list->size == 0;
+}
+
+void segarr_trim_to_size(segmented_array* list)
+{
+    if (!list)
+    {
+        return;
+    }
+
+    while ((list->block_count > 0) &&
+        (list->capacity - block_capacity(list->block_count - 1) >= list->size))
+    {
+        list->block_count--;
+        list->capacity -= block_capacity(list->block_count);
+        free(list->blocks[list->block_count]);
+        list->blocks[list->block_count] = nullptr;
+    }
+}
+
+/* Copies the elements to or from a contiguous buffer */
+static void segarr_transfer(segmented_array* list, unsigned char* buffer, const bool to_buffer)
+{
+    size_t block_start = 0;
+
+    for (size_t block = 0; block_start < list->size; ++block)
+    {
+        const size_t count = (list->size - block_start < block_capacity(block))
+                                 ? list->size - block_start
+                                 : block_capacity(block);
+        unsigned char* contiguous = buffer + (block_start * list->data_size);
+
+        if (to_buffer)
+        {
+            memcpy(contiguous, list->blocks[block], count * list->data_size);
+        }
+        else
+        {
+            memcpy(list->blocks[block], contiguous, count * list->data_size);
+        }
+
+        block_start += count;
+    }
+
+    DS_STATS_COUNT(list, bytes_copied, list->size * list->data_size);
+}
+
+static void swap_elements(unsigned char* a, unsigned char* b, size_t data_size)
+{
+    while (data_size--)
+    {
+        const unsigned char tmp = *a;
+        *a++ = *b;
+        *b++ = tmp;
+    }
+}
+
+static void segarr_sift_down(segmented_array* list, size_t root, const size_t end,
+                             int (*compar)(const void*, const void*))
+{
+    for (;;)
+    {
+        size_t child = (2 * root) + 1;
+
+        if (child >= end)
+        {
+            return;
+        }
+
+        if (child + 1 < end)
+        {
+            DS_STATS_COUNT(list, comparisons, 1);
+
+            if (compar(segarr_element(list, child), segarr_element(list, child + 1)) < 0)
+            {
+                child++;
+            }
+        }
+
+        DS_STATS_COUNT(list, comparisons, 1);
+
+        if (compar(segarr_element(list, root), segarr_element(list, child)) >= 0)
+        {
+            return;
+        }
+
+        swap_elements(segarr_element(list, root), segarr_element(list, child), list->data_size);
+        root = child;
+    }
+}
+
+/* Sorts without extra memory, for when the contiguous buffer cannot be allocated */
+static void segarr_heap_sort(segmented_array* list, int (*compar)(const void*, const void*))
+{
+    for (size_t i = list->size / 2; i > 0; --i)
+    {
+        segarr_sift_down(list, i - 1, list->size, compar);
+    }
+
+    for (size_t end = list->size - 1; end > 0; --end)
+    {
+        swap_elements(segarr_element(list, 0), segarr_element(list, end), list->data_size);
+        segarr_sift_down(list, 0, end, compar);
+    }
+}
+
+#ifdef DS_STATS
+/* qsort() passes no context, so the comparator being counted is kept per thread */
+static thread_local int (*counted_compar)(const void*, const void*);
+static thread_local uint64_t counted_comparisons;
+
+static int segarr_counting_compar(const void* a, const void* b)
+{
+    counted_comparisons++;
+    return counted_compar(a, b);
+}
+#endif
+
+/* Sorts contiguous elements of the list with qsort(), counting the comparisons */
+static void segarr_qsort(segmented_array* list, void* base, int (*compar)(const void*, const void*))
+{
+#ifdef DS_STATS
+    counted_compar = compar;
+    counted_comparisons = 0;
+    qsort(base, list->size, list->data_size, segarr_counting_compar);
+    DS_STATS_COUNT(list, comparisons, counted_comparisons);
+#else
+    qsort(base, list->size, list->data_size, compar);
+#endif
+}
+
+void segarr_sort(segmented_array* list, int (*compar)(const void*, const void*))
+{
+    if ((!list || !compar) || (list->size < 2))
+    {
+        return;
+    }
+
+    /* The first block holds everything, so it can be sorted where it is */
+    if (list->size <= block_capacity(0))
+    {
+        segarr_qsort(list, list->blocks[0], compar);
+        return;
+    }
+
+    unsigned char* buffer = malloc(list->size * list->data_size);
+
+    if (!buffer)
+    {
+        segarr_heap_sort(list, compar);
+        return;
+    }
+
+    segarr_transfer(list, buffer, true);
+    segarr_qsort(list, buffer, compar);
+    segarr_transfer(list, buffer, false);
+    free(buffer);
+}
+
+bool segarr_get_stats(const segmented_array* list, ds_stats* out_stats)
+{
+    if (!out_stats)
+    {
+        return false;
+    }
+
+#ifdef DS_STATS
+    if (!list)
+    {
+        return false;
+    }
+
+    ds_stats_load(&list->stats, out_stats);
+    return true;
+#else
+    (void)list;
+    memset(out_stats, 0, sizeof(ds_stats));
+    return false;
+#endif
+}
@@ -0,0 +1,103 @@
+/**************************************************************************
+ *   segmented_array.h  --                                                *
+ *   This file is part of Data Structures Library.                        *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#ifndef _DATASTRUCTURES_SEGMENTED_ARRAY_H
+#define _DATASTRUCTURES_SEGMENTED_ARRAY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ds_stats.h"
+
+/*
+ * A dynamic array stored in a directory of blocks, each twice as large as the previous one.
+ * Growing allocates a new block instead of moving the existing ones, so elements never move
+ * when the array grows and pointers to them stay valid until they are removed or the array is trimmed.
+ */
+
+/* The number of elements in the first block, a power of two */
+#ifndef SEGARR_FIRST_BLOCK_CAPACITY
+#define SEGARR_FIRST_BLOCK_CAPACITY 16
+#endif
+
+/* Structure type. */
+typedef struct SEGMENTED_ARRAY segmented_array;
+
+/**
+ * Initializes an empty segmented array.
+ * @param data_size The size of the data type to be stored in the list (in bytes).
+ * @returns a pointer to the segmented array initialized. */
+segmented_array* segarr_initialize(const size_t data_size);
+
+/**
+ * Destroys a segmented array and frees the allocated memory.
+ * @param list The segmented array to be destroyed. */
+void segarr_destroy(segmented_array* list);
+
+
+bool segarr_get(const segmented_array* list, const size_t index, void* out_data, const size_t data_size);
+
+/**
+ * Returns a pointer to an element, which stays valid while the array grows.
+ * It is invalidated by removing elements at or before @index, clearing and trimming.
+ * @param list The segmented array.
+ * @param index The index of the element.
+ * @returns a pointer to the element, or nullptr if the index is out of bounds. */
+void* segarr_get_at(const segmented_array* list, const size_t index);
+
+
+bool segarr_remove_at(segmented_array* list, const size_t index, void* out_data, const size_t data_size);
+
+
+bool segarr_add(segmented_array* list, const void* data, const size_t data_size);
+
+
+bool segarr_set(segmented_array* list, const size_t index, const void* data, const size_t data_size);
+
+
+bool segarr_contains(const segmented_array* list, const void* data, const size_t data_size);
+bool segarr_index_of(const segmented_array* list, const void* data, const size_t data_size, size_t* index);
+
+
+void segarr_clear(segmented_array* list);
+size_t segarr_size(const segmented_array* list);
+bool segarr_is_empty(const segmented_array* list);
+
+/**
+ * Frees the blocks past the last element.
+ * @param list The segmented array. */
+void segarr_trim_to_size(segmented_array* list);
+
+
+/**
+ * Sorts the elements.
+ * The elements are sorted in a temporary contiguous buffer, or in place with a heap sort
+ * if that buffer cannot be allocated.
+ * @param list The segmented array.
+ * @param compar The comparison function, as for qsort(). */
+void segarr_sort(segmented_array* list, int (*compar)(const void*, const void*));
+
+
+/**
+ * Reads the operation counters of a segmented array.
+ * @param list The segmented array.
+ * @param out_stats Receives the counters, zeroed when statistics are disabled.
+ * @returns true if the library was built with DS_STATS. */
+bool segarr_get_stats(const segmented_array* list, ds_stats* out_stats);
+
+#endif //_DATASTRUCTURES_SEGMENTED_ARRAY_H
@@ -14,6 +14,7 @@
  **************************************************************************/
 
 #include "singly_linked_list.h"
+#include "ds_stats.h"
 
 
 /* Singly linked node */
@@ -38,13 +39,22 @@ typedef struct singly_linked_list
     size_t size;
     /* The size of a single data element in bytes */
     size_t data_size;
+#ifdef DS_STATS
+    /* The operation counters of the list */
+    ds_atomic_stats stats;
+#endif
 } singly_linked_list;
 
 /* Local functions */
 static s_node* s_node_initialize(const void* data, const size_t data_size);
 static bool s_node_destroy(s_node* node);
 static bool s_node_has_next(const s_node* node);
-static s_node* s_node_get_kth(s_node* node, const size_t k);
+static s_node* s_node_get_kth(const singly_linked_list* list, s_node* node, const size_t k);
+static s_node* s_node_unlink_after(singly_linked_list* list, s_node* previous);
+static bool s_node_copy_chain(singly_linked_list* list, const s_node* source, const size_t count,
+                              s_node** first, s_node** last);
+static void s_list_link_chain(singly_linked_list* list, const size_t index, s_node* first, s_node* last,
+                              const size_t count);
 
 
 static s_node* s_node_initialize(const void* data, const size_t data_size)
@@ -56,7 +66,19 @@ static s_node* s_node_initialize(const void* data, const size_t data_size)
         return nullptr;
     }
 
-    memcpy(node->data, data, data_size);
+    node->data = malloc(data_size);
+
+    if (!node->data)
+    {
+        free(node);
+        return nullptr;
+    }
+
+    /* The data may be filled in by the caller */
+    if (data)
+    {
+        memcpy(node->data, data, data_size);
+    }
 
     return node;
 }
@@ -83,7 +105,7 @@ static bool s_node_has_next(const s_node* node)
     return node->next != nullptr;
 }
 
-static s_node* s_node_get_kth(s_node* node, const size_t k)
+static s_node* s_node_get_kth(const singly_linked_list* list, s_node* node, const size_t k)
 {
     if (!node)
     {
@@ -96,13 +118,107 @@ static s_node* s_node_get_kth(s_node* node, const size_t k)
         node = node->next;
         if (!node)
         {
+            DS_STATS_COUNT(list, traversal_steps, i + 1);
             return nullptr;
         }
         i++;
     }
+    DS_STATS_COUNT(list, traversal_steps, k);
     return node;
 }
 
+/* Unlinks the node following previous, or the head when previous is nullptr, and returns it */
+static s_node* s_node_unlink_after(singly_linked_list* list, s_node* previous)
+{
+    s_node* node = previous ? previous->next : list->head;
+
+    if (!node)
+    {
+        return nullptr;
+    }
+
+    if (previous)
+    {
+        previous->next = node->next;
+    }
+    else
+    {
+        list->head = node->next;
+    }
+
+    if (list->tail == node)
+    {
+        list->tail = previous;
+    }
+
+    node->next = nullptr;
+    list->size--;
+    return node;
+}
+
+/* Copies count nodes starting at source into a new chain, which is not linked into any list yet */
+static bool s_node_copy_chain(singly_linked_list* list, const s_node* source, const size_t count,
+                              s_node** first, s_node** last)
+{
+    s_node head = {0};
+    s_node* tail = &head;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        tail->next = s_node_initialize(source->data, list->data_size);
+
+        if (!tail->next)
+        {
+            while (head.next)
+            {
+                s_node* next = head.next->next;
+                s_node_destroy(head.next);
+                head.next = next;
+            }
+            return false;
+        }
+
+        tail = tail->next;
+        source = source->next;
+        DS_STATS_COUNT(list, allocations, 2);
+        DS_STATS_COUNT(list, bytes_copied, list->data_size);
+    }
+
+    *first = head.next;
+    *last = tail;
+    return true;
+}
+
+/* Links a chain of count nodes so that its first node takes the index */
+static void s_list_link_chain(singly_linked_list* list, const size_t index, s_node* first, s_node* last,
+                              const size_t count)
+{
+    if (index == 0)
+    {
+        last->next = list->head;
+        list->head = first;
+
+        if (!list->tail)
+        {
+            list->tail = last;
+        }
+    }
+    else if (index == list->size)
+    {
+        list->tail->next = first;
+        list->tail = last;
+    }
+    else
+    {
+        s_node* previous = s_node_get_kth(list, list->head, index - 1);
+        last->next = previous->next;
+        previous->next = first;
+    }
+
+    list->size += count;
+    DS_STATS_PEAK(list, list->size);
+}
+
 singly_linked_list* slist_initialize(const size_t data_size)
 {
     singly_linked_list* list = calloc(1, sizeof(singly_linked_list));
@@ -114,6 +230,7 @@ singly_linked_list* slist_initialize(const size_t data_size)
     list->tail = nullptr;
     list->size = 0;
     list->data_size = data_size;
+    DS_STATS_COUNT(list, allocations, 1);
     return list;
 }
 
@@ -144,6 +261,8 @@ singly_linked_list* slist_initialize_from(const singly_linked_list* list, const
 
     memcpy(new_list_current->data, list_current->data, data_size);
     new_list->tail = new_list_current;
+    DS_STATS_COUNT(new_list, allocations, 2);
+    DS_STATS_COUNT(new_list, bytes_copied, data_size);
 
     while (s_node_has_next(list_current))
     {
@@ -157,10 +276,14 @@ singly_linked_list* slist_initialize_from(const singly_linked_list* list, const
         new_list_current = new_list_current->next;
 
         list_current = list_current->next;
+        DS_STATS_COUNT(new_list, allocations, 2);
+        DS_STATS_COUNT(new_list, bytes_copied, data_size);
+        DS_STATS_COUNT(list, traversal_steps, 1);
     }
 
     new_list->tail = new_list_current;
     new_list->size = list->size;
+    DS_STATS_PEAK(new_list, new_list->size);
 
     return new_list;
 }
@@ -221,6 +344,7 @@ void* slist_get_at(const singly_linked_list* list, const size_t index)
         i++;
     }
 
+    DS_STATS_COUNT(list, traversal_steps, index);
     return current->data;
 }
 
@@ -240,26 +364,29 @@ singly_linked_list* slist_get_sub_list(const singly_linked_list* list, const siz
         return nullptr;
     }
 
-    sub_list->head = s_node_initialize(list->head->data, data_size);
+    const s_node* list_current = s_node_get_kth(list, list->head, start);
 
-    if (!sub_list->head)
+    if (!list_current)
     {
         slist_destroy(sub_list);
         return nullptr;
     }
 
-    sub_list->tail = sub_list->head;
-    sub_list->size++;
+    sub_list->head = s_node_initialize(list_current->data, data_size);
 
-    s_node* sub_list_current = sub_list->head;
-    const s_node* list_current = s_node_get_kth(list->head, start);
-
-    if (!list_current)
+    if (!sub_list->head)
     {
         slist_destroy(sub_list);
         return nullptr;
     }
 
+    sub_list->tail = sub_list->head;
+    sub_list->size++;
+    DS_STATS_COUNT(sub_list, allocations, 2);
+    DS_STATS_COUNT(sub_list, bytes_copied, data_size);
+
+    s_node* sub_list_current = sub_list->head;
+
     const size_t total_elements = end - start;
 
     while (sub_list->size < total_elements)
@@ -277,9 +404,563 @@ singly_linked_list* slist_get_sub_list(const singly_linked_list* list, const siz
         list_current = list_current->next;
 
         sub_list->size++;
+        DS_STATS_COUNT(sub_list, allocations, 2);
+        DS_STATS_COUNT(sub_list, bytes_copied, data_size);
+        DS_STATS_COUNT(list, traversal_steps, 1);
     }
 
     sub_list->tail = sub_list_current;
+    DS_STATS_PEAK(sub_list, sub_list->size);
 
     return sub_list;
-}
\ No newline at end of file
+}
+
+
+// The returned data is owned by the caller and must be freed.
+void* slist_remove_first(singly_linked_list* list)
+{
+    if ((!list) || (!list->size) || (!list->head))
+    {
+        return nullptr;
+    }
+
+    s_node* node = list->head;
+    void* data = node->data;
+
+    list->head = node->next;
+    list->size--;
+
+    if (!list->head)
+    {
+        list->tail = nullptr;
+    }
+
+    free(node);
+    return data;
+}
+
+// The returned data is owned by the caller and must be freed.
+void* slist_remove_last(singly_linked_list* list)
+{
+    if ((!list) || (!list->size) || (!list->tail))
+    {
+        return nullptr;
+    }
+
+    if (list->head == list->tail)
+    {
+        return slist_remove_first(list);
+    }
+
+    s_node* previous = s_node_get_kth(list, list->head, list->size - 2);
+
+    if (!previous)
+    {
+        return nullptr;
+    }
+
+    s_node* node = list->tail;
+    void* data = node->data;
+
+    previous->next = nullptr;
+    list->tail = previous;
+    list->size--;
+
+    free(node);
+    return data;
+}
+
+bool slist_remove_at(singly_linked_list* list, const size_t index)
+{
+    if ((!list) || (index >= list->size))
+    {
+        return false;
+    }
+
+    s_node* previous = index ? s_node_get_kth(list, list->head, index - 1) : nullptr;
+    s_node_destroy(s_node_unlink_after(list, previous));
+    return true;
+}
+
+bool slist_remove_element(singly_linked_list* list, const void* data, const size_t data_size)
+{
+    if ((!list || !data) || (list->data_size != data_size))
+    {
+        return false;
+    }
+
+    s_node* previous = nullptr;
+    size_t i = 0;
+
+    for (s_node* current = list->head; current; previous = current, current = current->next, ++i)
+    {
+        if (!memcmp(current->data, data, data_size))
+        {
+            DS_STATS_COUNT(list, comparisons, i + 1);
+            DS_STATS_COUNT(list, traversal_steps, i);
+            s_node_destroy(s_node_unlink_after(list, previous));
+            return true;
+        }
+    }
+
+    DS_STATS_COUNT(list, comparisons, i);
+    DS_STATS_COUNT(list, traversal_steps, i);
+    return false;
+}
+
+bool slist_remove_all(singly_linked_list* list, const singly_linked_list* other_list)
+{
+    if ((!list || !other_list) || (list == other_list) || (list->data_size != other_list->data_size))
+    {
+        return false;
+    }
+
+    for (const s_node* current = other_list->head; current; current = current->next)
+    {
+        slist_remove_element(list, current->data, other_list->data_size);
+    }
+
+    return true;
+}
+
+// The element at index end is excluded and not removed.
+void slist_remove_range(singly_linked_list* list, const size_t start, const size_t end)
+{
+    if ((!list) || (start >= list->size) || (end > list->size) || (start >= end))
+    {
+        return;
+    }
+
+    s_node* previous = start ? s_node_get_kth(list, list->head, start - 1) : nullptr;
+
+    for (size_t i = start; i < end; ++i)
+    {
+        s_node_destroy(s_node_unlink_after(list, previous));
+    }
+}
+
+bool slist_add_first(singly_linked_list* list, const void* data, const size_t data_size)
+{
+    if ((!list || !data) || (list->data_size != data_size) || (list->size == SIZE_MAX))
+    {
+        return false;
+    }
+
+    s_node* node = s_node_initialize(data, data_size);
+
+    if (!node)
+    {
+        return false;
+    }
+
+    node->next = list->head;
+    list->head = node;
+
+    if (!list->tail)
+    {
+        list->tail = node;
+    }
+
+    list->size++;
+    DS_STATS_COUNT(list, allocations, 2);
+    DS_STATS_COUNT(list, bytes_copied, data_size);
+    DS_STATS_PEAK(list, list->size);
+    return true;
+}
+
+bool slist_add_last(singly_linked_list* list, const void* data, const size_t data_size)
+{
+    if ((!list || !data) || (list->data_size != data_size) || (list->size == SIZE_MAX))
+    {
+        return false;
+    }
+
+    s_node* node = s_node_initialize(data, data_size);
+
+    if (!node)
+    {
+        return false;
+    }
+
+    if (list->tail)
+    {
+        list->tail->next = node;
+    }
+    else
+    {
+        list->head = node;
+    }
+
+    list->tail = node;
+    list->size++;
+    DS_STATS_COUNT(list, allocations, 2);
+    DS_STATS_COUNT(list, bytes_copied, data_size);
+    DS_STATS_PEAK(list, list->size);
+    return true;
+}
+
+bool slist_add_all(singly_linked_list* list, const singly_linked_list* other_list)
+{
+    if (!list)
+    {
+        return false;
+    }
+
+    return slist_add_all_at(list, list->size, other_list);
+}
+
+bool slist_add_all_at(singly_linked_list* list, const size_t index, const singly_linked_list* other_list)
+{
+    if ((!list || !other_list) || (index > list->size) || (list->data_size != other_list->data_size) ||
+        (list->size > SIZE_MAX - other_list->size))
+    {
+        return false;
+    }
+
+    if (!other_list->size)
+    {
+        return true;
+    }
+
+    /* The copy is made before linking, which also makes adding a list to itself safe */
+    const size_t count = other_list->size;
+    s_node* first;
+    s_node* last;
+
+    if (!s_node_copy_chain(list, other_list->head, count, &first, &last))
+    {
+        return false;
+    }
+
+    s_list_link_chain(list, index, first, last, count);
+    return true;
+}
+
+bool slist_insert(singly_linked_list* list, const size_t index, const void* data, const size_t data_size)
+{
+    if ((!list || !data) || (list->data_size != data_size) || (index > list->size) || (list->size == SIZE_MAX))
+    {
+        return false;
+    }
+
+    s_node* node = s_node_initialize(data, data_size);
+
+    if (!node)
+    {
+        return false;
+    }
+
+    s_list_link_chain(list, index, node, node, 1);
+    DS_STATS_COUNT(list, allocations, 2);
+    DS_STATS_COUNT(list, bytes_copied, data_size);
+    return true;
+}
+
+bool slist_splice_last(singly_linked_list* list, singly_linked_list* other_list)
+{
+    if (!list)
+    {
+        return false;
+    }
+
+    return slist_splice_at(list, list->size, other_list);
+}
+
+bool slist_splice_at(singly_linked_list* list, const size_t index, singly_linked_list* other_list)
+{
+    if ((!list || !other_list) || (list == other_list) || (list->data_size != other_list->data_size) ||
+        (index > list->size) || (list->size > SIZE_MAX - other_list->size))
+    {
+        return false;
+    }
+
+    if (!other_list->head)
+    {
+        return true;
+    }
+
+    s_list_link_chain(list, index, other_list->head, other_list->tail, other_list->size);
+
+    other_list->head = nullptr;
+    other_list->tail = nullptr;
+    other_list->size = 0;
+    return true;
+}
+
+singly_linked_list* slist_split_at(singly_linked_list* list, const size_t index)
+{
+    if ((!list) || (index > list->size))
+    {
+        return nullptr;
+    }
+
+    singly_linked_list* tail_list = slist_initialize(list->data_size);
+
+    if ((!tail_list) || (index == list->size))
+    {
+        return tail_list;
+    }
+
+    tail_list->tail = list->tail;
+
+    if (index == 0)
+    {
+        tail_list->head = list->head;
+        list->head = nullptr;
+        list->tail = nullptr;
+    }
+    else
+    {
+        s_node* previous = s_node_get_kth(list, list->head, index - 1);
+        tail_list->head = previous->next;
+        previous->next = nullptr;
+        list->tail = previous;
+    }
+
+    tail_list->size = list->size - index;
+    list->size = index;
+    DS_STATS_PEAK(tail_list, tail_list->size);
+
+    return tail_list;
+}
+
+void* slist_set(singly_linked_list* list, const size_t index, const void* data, const size_t data_size)
+{
+    if ((!list || !data) || (list->data_size != data_size) || (index >= list->size))
+    {
+        return nullptr;
+    }
+
+    s_node* node = s_node_get_kth(list, list->head, index);
+    memcpy(node->data, data, data_size);
+    DS_STATS_COUNT(list, bytes_copied, data_size);
+    return node->data;
+}
+
+
+bool slist_contains(const singly_linked_list* list, const void* data, const size_t data_size)
+{
+    size_t index;
+    return slist_index_of(list, data, data_size, &index);
+}
+
+bool slist_index_of(const singly_linked_list* list, const void* data, const size_t data_size, size_t* index)
+{
+    if ((!list || !data || !index) || (list->data_size != data_size))
+    {
+        return false;
+    }
+
+    size_t i = 0;
+    for (const s_node* current = list->head; current; current = current->next, ++i)
+    {
+        if (!memcmp(current->data, data, data_size))
+        {
+            DS_STATS_COUNT(list, comparisons, i + 1);
+            DS_STATS_COUNT(list, traversal_steps, i);
+            *index = i;
+            return true;
+        }
+    }
+
+    DS_STATS_COUNT(list, comparisons, list->size);
+    DS_STATS_COUNT(list, traversal_steps, list->size);
+    return false;
+}
+
+// The list has no backward links, so the whole list is walked once, remembering the last match.
+bool slist_last_index_of(const singly_linked_list* list, const void* data, const size_t data_size, size_t* index)
+{
+    if ((!list || !data || !index) || (list->data_size != data_size))
+    {
+        return false;
+    }
+
+    bool found = false;
+    size_t i = 0;
+
+    for (const s_node* current = list->head; current; current = current->next, ++i)
+    {
+        if (!memcmp(current->data, data, data_size))
+        {
+            *index = i;
+            found = true;
+        }
+    }
+
+    DS_STATS_COUNT(list, comparisons, list->size);
+    DS_STATS_COUNT(list, traversal_steps, list->size);
+    return found;
+}
+
+// Note: If the list stores pointers or other lists they should be freed individually before calling slist_clear()
+// As that would cause a memory leak.
+void slist_clear(singly_linked_list* list)
+{
+    if (!list)
+    {
+        return;
+    }
+
+    s_node* current = list->head;
+    while (current)
+    {
+        s_node* next = current->next;
+        s_node_destroy(current);
+        current = next;
+    }
+
+    list->head = nullptr;
+    list->tail = nullptr;
+    list->size = 0;
+}
+
+size_t slist_size(const singly_linked_list* list)
+{
+    if (!list)
+    {
+        return 0;
+    }
+
+    return list->size;
+}
+
+bool slist_is_empty(const singly_linked_list* list)
+{
+    if (!list)
+    {
+        return true;
+    }
+
+    return list->size == 0;
+}
+
+
+void slist_reverse(singly_linked_list* list)
+{
+    if (!list)
+    {
+        return;
+    }
+
+    s_node* previous = nullptr;
+    s_node* current = list->head;
+
+    while (current)
+    {
+        s_node* next = current->next;
+        current->next = previous;
+        previous = current;
+        current = next;
+    }
+
+    list->tail = list->head;
+    list->head = previous;
+    DS_STATS_COUNT(list, traversal_steps, list->size);
+}
+
+/* Merges two sorted chains, taking from left on ties to stay stable */
+static s_node* s_node_merge(const singly_linked_list* list, s_node* left, s_node* right,
+                            int (compar)(const void*, const void*))
+{
+    s_node head = {0};
+    s_node* tail = &head;
+
+    while (left && right)
+    {
+        DS_STATS_COUNT(list, comparisons, 1);
+        if (compar(right->data, left->data) < 0)
+        {
+            tail->next = right;
+            right = right->next;
+        }
+        else
+        {
+            tail->next = left;
+            left = left->next;
+        }
+        tail = tail->next;
+    }
+
+    tail->next = left ? left : right;
+    return head.next;
+}
+
+/* Detaches the first count nodes of a chain and returns the rest */
+static s_node* s_node_cut(s_node* first, const size_t count)
+{
+    for (size_t i = 1; (i < count) && first; ++i)
+    {
+        first = first->next;
+    }
+
+    if (!first)
+    {
+        return nullptr;
+    }
+
+    s_node* rest = first->next;
+    first->next = nullptr;
+    return rest;
+}
+
+void slist_sort(singly_linked_list* list, int (compar)(const void*, const void*))
+{
+    if ((!list) || (!compar) || (list->size < 2))
+    {
+        return;
+    }
+
+    /* Bottom-up merge sort: runs of width 1, 2, 4... are merged pairwise without recursion or extra memory */
+    s_node* head = list->head;
+    s_node* tail = nullptr;
+
+    for (size_t width = 1; width < list->size; width *= 2)
+    {
+        s_node merged = {0};
+        tail = &merged;
+        s_node* rest = head;
+
+        while (rest)
+        {
+            s_node* left = rest;
+            s_node* right = s_node_cut(left, width);
+            rest = s_node_cut(right, width);
+
+            tail->next = s_node_merge(list, left, right, compar);
+            while (tail->next)
+            {
+                tail = tail->next;
+            }
+            DS_STATS_COUNT(list, traversal_steps, width * 2);
+        }
+
+        head = merged.next;
+    }
+
+    list->head = head;
+    list->tail = tail;
+}
+
+
+bool slist_get_stats(const singly_linked_list* list, ds_stats* out_stats)
+{
+    if (!out_stats)
+    {
+        return false;
+    }
+
+#ifdef DS_STATS
+    if (!list)
+    {
+        return false;
+    }
+
+    ds_stats_load(&list->stats, out_stats);
+    return true;
+#else
+    (void)list;
+    memset(out_stats, 0, sizeof(ds_stats));
+    return false;
+#endif
+}
@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "ds_stats.h"
 
 typedef struct singly_linked_list singly_linked_list;
 
@@ -53,6 +54,29 @@ bool slist_add_all_at(singly_linked_list* list, const size_t index, const singly
 bool slist_insert(singly_linked_list* list, const size_t index, const void* data, const size_t data_size);
 
 
+/**
+ * Moves every node of another list to the end of a list in O(1), without copying, leaving the other list empty.
+ * @param list The singly linked list receiving the nodes.
+ * @param other_list The singly linked list giving its nodes, storing the same data size.
+ * @returns true if the nodes were moved, false otherwise. */
+bool slist_splice_last(singly_linked_list* list, singly_linked_list* other_list);
+
+/**
+ * Moves every node of another list in front of an index in O(index), without copying, leaving the other list empty.
+ * @param list The singly linked list receiving the nodes.
+ * @param index The index the first moved node takes, up to slist_size().
+ * @param other_list The singly linked list giving its nodes, storing the same data size.
+ * @returns true if the nodes were moved, false otherwise. */
+bool slist_splice_at(singly_linked_list* list, const size_t index, singly_linked_list* other_list);
+
+/**
+ * Detaches the nodes from an index to the end into a new list in O(index), without copying.
+ * @param list The singly linked list, keeping the nodes before @index.
+ * @param index The index of the first node to detach, up to slist_size().
+ * @returns the new list holding the detached nodes, or nullptr on failure. */
+singly_linked_list* slist_split_at(singly_linked_list* list, const size_t index);
+
+
 void* slist_set(singly_linked_list* list, const size_t index, const void* data, const size_t data_size);
 
 
@@ -70,4 +94,17 @@ void slist_reverse(singly_linked_list* list);
 void slist_sort(singly_linked_list* list, int (compar)(const void*, const void*));
 
 
+/**
+ * Reads the operation counters of a singly linked list.
+ * @param list The singly linked list.
+ * @param out_stats Receives the counters, zeroed when statistics are disabled.
+ * @returns true if the library was built with DS_STATS. */
+bool slist_get_stats(const singly_linked_list* list, ds_stats* out_stats);
+
+
+/* Routes the calls of including code through the workload tracing shim */
+#ifdef DS_TRACE
+#include "ds_trace.h"
+#endif
+
 #endif //_DATASTRUCTURES_SINGLY_LINKED_LIST_H
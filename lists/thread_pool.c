@@ -0,0 +1,353 @@
+/**************************************************************************
+ *   thread_pool.c  --  This file is part of Data Structures Library.     *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#include "thread_pool.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* The chunks left to one participant, stolen from the back by the others */
+typedef struct chunk_range
+{
+    atomic_flag lock;
+    size_t begin;
+    size_t end;
+} chunk_range;
+
+/* A parallel loop being run by the pool */
+typedef struct pool_job
+{
+    thread_pool_task task;
+    void* ctx;
+    /* One range per participant, the calling thread owns the first */
+    chunk_range* ranges;
+    size_t participants;
+} pool_job;
+
+/* Structure type. */
+typedef struct thread_pool
+{
+    pthread_t* workers;
+    size_t worker_count;
+    /* Guards everything below */
+    pthread_mutex_t mutex;
+    /* Signals workers that a job was posted or the pool is stopping */
+    pthread_cond_t job_posted;
+    /* Signals the caller that the last worker left the job */
+    pthread_cond_t job_done;
+    pool_job* job;
+    /* Incremented for every job, so workers join each one exactly once */
+    uint64_t generation;
+    /* The generation when the workers were started */
+    uint64_t start_generation;
+    /* The number of workers still running the current job */
+    size_t busy;
+    bool stopping;
+} thread_pool;
+
+static thread_pool pool = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .job_posted = PTHREAD_COND_INITIALIZER,
+    .job_done = PTHREAD_COND_INITIALIZER,
+};
+
+/* Serializes parallel loops and pool restarts */
+static pthread_mutex_t pool_run_mutex = PTHREAD_MUTEX_INITIALIZER;
+static bool pool_started;
+
+/* Set while the thread runs a task, so nested loops run serially instead of waiting on the pool */
+static thread_local bool in_pool_task;
+
+static void range_lock(chunk_range* range)
+{
+    while (atomic_flag_test_and_set_explicit(&range->lock, memory_order_acquire))
+    {
+    }
+}
+
+static void range_unlock(chunk_range* range)
+{
+    atomic_flag_clear_explicit(&range->lock, memory_order_release);
+}
+
+/* Takes the next chunk of the participant's own range */
+static bool range_pop(chunk_range* range, size_t* chunk)
+{
+    range_lock(range);
+    const bool res = range->begin < range->end;
+
+    if (res)
+    {
+        *chunk = range->begin++;
+    }
+
+    range_unlock(range);
+    return res;
+}
+
+/* Moves the back half of a victim's range into the thief's (empty) range */
+static bool range_steal(chunk_range* victim, chunk_range* thief)
+{
+    range_lock(victim);
+    const size_t left = victim->end - victim->begin;
+
+    if (left == 0)
+    {
+        range_unlock(victim);
+        return false;
+    }
+
+    const size_t end = victim->end;
+    victim->end -= (left + 1) / 2;
+    const size_t begin = victim->end;
+    range_unlock(victim);
+
+    range_lock(thief);
+    thief->begin = begin;
+    thief->end = end;
+    range_unlock(thief);
+    return true;
+}
+
+/* The first chunk of a participant's share, the remainder going one chunk each to the first participants */
+static size_t pool_range_start(const size_t chunks, const size_t participants, const size_t participant)
+{
+    const size_t share = chunks / participants;
+    const size_t remainder = chunks % participants;
+    return (share * participant) + ((participant < remainder) ? participant : remainder);
+}
+
+static void participate(const pool_job* job, const size_t slot)
+{
+    chunk_range* own = &job->ranges[slot];
+    size_t chunk;
+
+    in_pool_task = true;
+
+    for (;;)
+    {
+        while (range_pop(own, &chunk))
+        {
+            job->task(chunk, chunk + 1, job->ctx);
+        }
+
+        bool stolen = false;
+
+        for (size_t i = 1; (i < job->participants) && !stolen; ++i)
+        {
+            stolen = range_steal(&job->ranges[(slot + i) % job->participants], own);
+        }
+
+        /* Every range was empty; chunks still being moved by a thief are run by that thief */
+        if (!stolen)
+        {
+            break;
+        }
+    }
+
+    in_pool_task = false;
+}
+
+static void* worker_main(void* arg)
+{
+    const size_t slot = (size_t)(uintptr_t)arg;
+
+    pthread_mutex_lock(&pool.mutex);
+
+    uint64_t seen = pool.start_generation;
+
+    for (;;)
+    {
+        while (!pool.stopping && (pool.generation == seen))
+        {
+            pthread_cond_wait(&pool.job_posted, &pool.mutex);
+        }
+
+        if (pool.stopping)
+        {
+            break;
+        }
+
+        seen = pool.generation;
+        const pool_job* job = pool.job;
+        pthread_mutex_unlock(&pool.mutex);
+
+        participate(job, slot);
+
+        pthread_mutex_lock(&pool.mutex);
+
+        if (--pool.busy == 0)
+        {
+            pthread_cond_signal(&pool.job_done);
+        }
+    }
+
+    pthread_mutex_unlock(&pool.mutex);
+    return nullptr;
+}
+
+static void pool_stop_locked(void)
+{
+    if (!pool_started)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&pool.mutex);
+    pool.stopping = true;
+    pthread_cond_broadcast(&pool.job_posted);
+    pthread_mutex_unlock(&pool.mutex);
+
+    for (size_t i = 0; i < pool.worker_count; ++i)
+    {
+        pthread_join(pool.workers[i], nullptr);
+    }
+
+    free(pool.workers);
+    pool.workers = nullptr;
+    pool.worker_count = 0;
+    pool.stopping = false;
+    pool_started = false;
+}
+
+static bool pool_start_locked(size_t threads)
+{
+    if (threads == 0)
+    {
+        const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 1 ? (size_t)cpus - 1 : 0;
+    }
+
+    pool.workers = calloc(threads ? threads : 1, sizeof(pthread_t));
+
+    if (!pool.workers)
+    {
+        return false;
+    }
+
+    /* Workers only join jobs posted after they started */
+    pthread_mutex_lock(&pool.mutex);
+    pool.start_generation = pool.generation;
+
+    for (size_t i = 0; i < threads; ++i)
+    {
+        /* Slot 0 belongs to the calling thread */
+        if (pthread_create(&pool.workers[i], nullptr, worker_main, (void*)(uintptr_t)(i + 1)) != 0)
+        {
+            break;
+        }
+
+        pool.worker_count++;
+    }
+
+    pthread_mutex_unlock(&pool.mutex);
+
+    pool_started = true;
+    return pool.worker_count == threads;
+}
+
+void thread_pool_parallel_for(const size_t chunks, thread_pool_task task, void* ctx)
+{
+    if ((chunks == 0) || !task)
+    {
+        return;
+    }
+
+    if (in_pool_task || (chunks == 1))
+    {
+        task(0, chunks, ctx);
+        return;
+    }
+
+    pthread_mutex_lock(&pool_run_mutex);
+
+    if (!pool_started)
+    {
+        pool_start_locked(0);
+    }
+
+    const size_t participants = pool.worker_count + 1;
+    chunk_range* ranges = (participants > 1) ? calloc(participants, sizeof(chunk_range)) : nullptr;
+
+    if (!ranges)
+    {
+        pthread_mutex_unlock(&pool_run_mutex);
+        task(0, chunks, ctx);
+        return;
+    }
+
+    for (size_t i = 0; i < participants; ++i)
+    {
+        atomic_flag_clear(&ranges[i].lock);
+        ranges[i].begin = pool_range_start(chunks, participants, i);
+        ranges[i].end = pool_range_start(chunks, participants, i + 1);
+    }
+
+    pool_job job = {task, ctx, ranges, participants};
+
+    pthread_mutex_lock(&pool.mutex);
+    pool.job = &job;
+    pool.busy = pool.worker_count;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.job_posted);
+    pthread_mutex_unlock(&pool.mutex);
+
+    participate(&job, 0);
+
+    pthread_mutex_lock(&pool.mutex);
+
+    while (pool.busy > 0)
+    {
+        pthread_cond_wait(&pool.job_done, &pool.mutex);
+    }
+
+    pool.job = nullptr;
+    pthread_mutex_unlock(&pool.mutex);
+
+    free(ranges);
+    pthread_mutex_unlock(&pool_run_mutex);
+}
+
+bool thread_pool_set_threads(const size_t threads)
+{
+    pthread_mutex_lock(&pool_run_mutex);
+    pool_stop_locked();
+    const bool res = pool_start_locked(threads);
+    pthread_mutex_unlock(&pool_run_mutex);
+    return res;
+}
+
+size_t thread_pool_threads(void)
+{
+    pthread_mutex_lock(&pool_run_mutex);
+
+    if (!pool_started)
+    {
+        pool_start_locked(0);
+    }
+
+    const size_t threads = pool.worker_count + 1;
+    pthread_mutex_unlock(&pool_run_mutex);
+    return threads;
+}
+
+void thread_pool_shutdown(void)
+{
+    pthread_mutex_lock(&pool_run_mutex);
+    pool_stop_locked();
+    pthread_mutex_unlock(&pool_run_mutex);
+}
@@ -0,0 +1,52 @@
+/**************************************************************************
+ *   thread_pool.h  --  This file is part of Data Structures Library.     *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#ifndef _DATASTRUCTURES_THREAD_POOL_H
+#define _DATASTRUCTURES_THREAD_POOL_H
+
+#include <stddef.h>
+
+/*
+ * The library-wide thread pool used by the parallel container operations.
+ * Work is split into chunks that are dealt out evenly to the participating threads;
+ * a thread that runs out of chunks steals half of the chunks left to another one.
+ * The pool is started on first use with one worker per online CPU besides the calling thread.
+ */
+
+/* Runs the chunks [begin, end) of a parallel loop. */
+typedef void (*thread_pool_task)(size_t begin, size_t end, void* ctx);
+
+/**
+ * Runs a task over chunks [0, chunks) on the pool and the calling thread, and waits for it to finish.
+ * Calls made from inside a task, or when the pool cannot be started, run serially on the calling thread.
+ * @param chunks The number of chunks.
+ * @param task The task run on ranges of chunks, each chunk exactly once.
+ * @param ctx The context passed to the task. */
+void thread_pool_parallel_for(const size_t chunks, thread_pool_task task, void* ctx);
+
+/**
+ * Restarts the pool with a number of worker threads.
+ * @param threads The number of workers besides the calling thread, 0 for one per online CPU minus one.
+ * @returns true if the workers were started. */
+bool thread_pool_set_threads(const size_t threads);
+
+/**
+ * Returns the number of threads that run a parallel loop, including the calling thread. */
+size_t thread_pool_threads(void);
+
+/**
+ * Stops and joins the worker threads. The pool starts again on the next parallel loop. */
+void thread_pool_shutdown(void);
+
+#endif //_DATASTRUCTURES_THREAD_POOL_H
@@ -0,0 +1,188 @@
+/**************************************************************************
+ *   cintarr_test.c  --  This file is part of Data Structures Library.    *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+/*
+ * Round-trips compressed integer arrays whose blocks are packed at every width,
+ * in frame-of-reference and in delta mode, as well as empty and single-value arrays.
+ */
+
+#include "../lists/compressed_int_array.h"
+#include "test_check.h"
+
+/* Three compressed blocks and a partial tail */
+#define CINTARR_TEST_SIZE ((3 * CINTARR_BLOCK_SIZE) + 5)
+
+static uint64_t width_mask(const unsigned bits)
+{
+    return (bits == 64) ? UINT64_MAX : (((uint64_t)1 << bits) - 1);
+}
+
+/* Checks every way of reading the values back against @values */
+static void check_round_trip(const uint64_t* values, const size_t size)
+{
+    compressed_int_array* list = cintarr_initialize();
+    CHECK(list);
+
+    if (!list)
+    {
+        return;
+    }
+
+    bool sorted = true;
+    for (size_t i = 0; i < size; ++i)
+    {
+        CHECK(cintarr_add(list, values[i]));
+        sorted = sorted && ((i == 0) || (values[i - 1] <= values[i]));
+    }
+
+    CHECK(cintarr_size(list) == size);
+    CHECK(cintarr_is_empty(list) == (size == 0));
+    CHECK(cintarr_is_sorted(list) == sorted);
+
+    /* Random access, which starts delta reads from an anchor */
+    for (size_t i = 0; i < size; ++i)
+    {
+        uint64_t value = 0;
+        CHECK(cintarr_get(list, i, &value) && (value == values[i]));
+    }
+
+    uint64_t value = 0;
+    CHECK(!cintarr_get(list, size, &value));
+
+    cintarr_iterator iterator;
+    cintarr_iterator_init(list, 0, &iterator);
+    size_t count = 0;
+    while (cintarr_iterator_next(&iterator, &value))
+    {
+        CHECK((count < size) && (value == values[count]));
+        count++;
+    }
+    CHECK(count == size);
+
+    dynamic_array* array = cintarr_to_dynarr(list);
+    CHECK(array && (dynarr_size(array) == size));
+    compressed_int_array* copy = cintarr_initialize_from(array);
+    CHECK(copy && (cintarr_size(copy) == size));
+
+    for (size_t i = 0; copy && (i < size); ++i)
+    {
+        CHECK(cintarr_get(copy, i, &value) && (value == values[i]));
+    }
+
+    if (sorted)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            size_t index = SIZE_MAX;
+            CHECK(cintarr_binary_search(list, values[i], &index));
+            CHECK((index <= i) && (values[index] == values[i]));
+        }
+    }
+
+    /* Trimming keeps the values readable */
+    cintarr_trim_to_size(list);
+    for (size_t i = 0; i < size; ++i)
+    {
+        CHECK(cintarr_get(list, i, &value) && (value == values[i]));
+    }
+
+    cintarr_destroy(copy);
+    dynarr_destroy(array);
+    cintarr_destroy(list);
+}
+
+static void test_frame_of_reference_widths(uint64_t* values)
+{
+    for (unsigned bits = 0; bits <= 64; ++bits)
+    {
+        const uint64_t mask = width_mask(bits);
+        const uint64_t base = (bits == 64) ? 0 : 12345;
+
+        /* Not ascending, so the offsets from the minimum are packed on exactly @bits bits */
+        for (size_t i = 0; i < CINTARR_TEST_SIZE; ++i)
+        {
+            values[i] = base + ((i % 3 == 1) ? mask : ((i % 3 == 2) ? mask / 2 : 0));
+        }
+
+        check_round_trip(values, CINTARR_TEST_SIZE);
+    }
+}
+
+static void test_delta_widths(uint64_t* values)
+{
+    /* Stops before the last value would overflow */
+    for (unsigned bits = 0; width_mask(bits) <= UINT64_MAX / CINTARR_TEST_SIZE; ++bits)
+    {
+        const uint64_t mask = width_mask(bits);
+
+        /* Ascending with gaps alternating between 3 and 3 + mask, packed on exactly @bits bits */
+        values[0] = 1000;
+        for (size_t i = 1; i < CINTARR_TEST_SIZE; ++i)
+        {
+            values[i] = values[i - 1] + 3 + ((i % 2) ? mask : 0);
+        }
+
+        check_round_trip(values, CINTARR_TEST_SIZE);
+    }
+}
+
+static void test_small_arrays(void)
+{
+    check_round_trip(nullptr, 0);
+
+    const uint64_t single[] = {UINT64_MAX};
+    check_round_trip(single, 1);
+
+    const uint64_t zero[] = {0};
+    check_round_trip(zero, 1);
+}
+
+static void test_initialize_from_width(void)
+{
+    /* The element size is checked even when there is no element to read */
+    dynamic_array* narrow = dynarr_initialize_empty(sizeof(uint32_t));
+    CHECK(narrow);
+    CHECK(cintarr_initialize_from(narrow) == nullptr);
+
+    const uint32_t value = 7;
+    CHECK(dynarr_add(narrow, &value, sizeof(uint32_t)));
+    CHECK(cintarr_initialize_from(narrow) == nullptr);
+    dynarr_destroy(narrow);
+
+    dynamic_array* empty = dynarr_initialize_empty(sizeof(uint64_t));
+    compressed_int_array* list = cintarr_initialize_from(empty);
+    CHECK(list && cintarr_is_empty(list));
+    cintarr_destroy(list);
+    dynarr_destroy(empty);
+
+    CHECK(cintarr_initialize_from(nullptr) == nullptr);
+}
+
+int main(void)
+{
+    uint64_t* values = malloc(CINTARR_TEST_SIZE * sizeof(uint64_t));
+    CHECK(values);
+
+    if (values)
+    {
+        test_frame_of_reference_widths(values);
+        test_delta_widths(values);
+    }
+
+    test_small_arrays();
+    test_initialize_from_width();
+
+    free(values);
+    return TEST_RESULT();
+}
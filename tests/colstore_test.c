@@ -0,0 +1,190 @@
+/**************************************************************************
+ *   colstore_test.c  --  This file is part of Data Structures Library.   *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+/*
+ * Sorts column stores by one column and checks that every other column followed
+ * the same permutation, that no row was lost or duplicated, and that the sort is stable.
+ */
+
+#include "../lists/column_store.h"
+#include "test_check.h"
+
+typedef struct test_row
+{
+    uint8_t tag;
+    uint32_t key;
+    uint64_t id;
+} test_row;
+
+enum
+{
+    FIELD_TAG,
+    FIELD_KEY,
+    FIELD_ID
+};
+
+/* The fields of the row with id @id, so a row can be checked against its id after it moved */
+static test_row make_row(const uint64_t id)
+{
+    return (test_row){(uint8_t)(id * 31), (uint32_t)((id * 7919) % 17), id};
+}
+
+static int compare_uint32(const void* a, const void* b)
+{
+    const uint32_t x = *(const uint32_t*)a;
+    const uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_uint8(const void* a, const void* b)
+{
+    return (int)*(const uint8_t*)a - (int)*(const uint8_t*)b;
+}
+
+static column_store* make_store(const size_t rows)
+{
+    const colstore_field fields[] = {
+        COLSTORE_FIELD(test_row, tag),
+        COLSTORE_FIELD(test_row, key),
+        COLSTORE_FIELD(test_row, id),
+    };
+    column_store* store = colstore_initialize(fields, 3, sizeof(test_row));
+    CHECK(store);
+
+    for (size_t i = 0; store && (i < rows); ++i)
+    {
+        const test_row row = make_row(i);
+        CHECK(colstore_add_row(store, &row, sizeof(test_row)));
+    }
+
+    return store;
+}
+
+/* Checks that the rows are a permutation of the rows added, and that every row kept its own fields */
+static void check_permutation(const column_store* store, const size_t rows)
+{
+    bool* seen = calloc(rows ? rows : 1, sizeof(bool));
+    CHECK(seen);
+    CHECK(colstore_rows(store) == rows);
+
+    for (size_t i = 0; seen && (i < rows); ++i)
+    {
+        test_row row;
+        CHECK(colstore_get_row(store, i, &row, sizeof(test_row)));
+        CHECK(row.id < rows);
+
+        if (row.id < rows)
+        {
+            CHECK(!seen[row.id]);
+            seen[row.id] = true;
+        }
+
+        const test_row expected = make_row(row.id);
+        CHECK((row.tag == expected.tag) && (row.key == expected.key));
+
+        /* The columns read directly agree with the gathered rows */
+        CHECK(((const uint32_t*)colstore_column(store, FIELD_KEY))[i] == row.key);
+        CHECK(((const uint64_t*)colstore_column(store, FIELD_ID))[i] == row.id);
+    }
+
+    free(seen);
+}
+
+static void test_sort_by_key(const size_t rows)
+{
+    column_store* store = make_store(rows);
+
+    if (!store)
+    {
+        return;
+    }
+
+    CHECK(colstore_sort_by(store, FIELD_KEY, compare_uint32));
+    check_permutation(store, rows);
+
+    /* Equal keys keep their insertion order, which is the order of their ids */
+    for (size_t i = 1; i < rows; ++i)
+    {
+        test_row previous;
+        test_row row;
+        CHECK(colstore_get_row(store, i - 1, &previous, sizeof(test_row)));
+        CHECK(colstore_get_row(store, i, &row, sizeof(test_row)));
+        CHECK((previous.key < row.key) || ((previous.key == row.key) && (previous.id < row.id)));
+    }
+
+    colstore_destroy(store);
+}
+
+static void test_sort_twice(void)
+{
+    const size_t rows = 1000;
+    column_store* store = make_store(rows);
+
+    if (!store)
+    {
+        return;
+    }
+
+    /* Sorting by tag after key orders by tag, then by key, then by id */
+    CHECK(colstore_sort_by(store, FIELD_KEY, compare_uint32));
+    CHECK(colstore_sort_by(store, FIELD_TAG, compare_uint8));
+    check_permutation(store, rows);
+
+    for (size_t i = 1; i < rows; ++i)
+    {
+        test_row previous;
+        test_row row;
+        CHECK(colstore_get_row(store, i - 1, &previous, sizeof(test_row)));
+        CHECK(colstore_get_row(store, i, &row, sizeof(test_row)));
+        CHECK((previous.tag < row.tag) || ((previous.tag == row.tag) && (previous.key < row.key)) ||
+              ((previous.tag == row.tag) && (previous.key == row.key) && (previous.id < row.id)));
+    }
+
+    colstore_destroy(store);
+}
+
+static void test_sort_invalid(void)
+{
+    column_store* store = make_store(4);
+
+    if (!store)
+    {
+        return;
+    }
+
+    CHECK(!colstore_sort_by(store, 3, compare_uint32));
+    CHECK(!colstore_sort_by(store, FIELD_KEY, nullptr));
+    CHECK(!colstore_sort_by(nullptr, FIELD_KEY, compare_uint32));
+
+    /* A failed sort leaves the rows in place */
+    for (size_t i = 0; i < 4; ++i)
+    {
+        test_row row;
+        CHECK(colstore_get_row(store, i, &row, sizeof(test_row)) && (row.id == i));
+    }
+
+    colstore_destroy(store);
+}
+
+int main(void)
+{
+    test_sort_by_key(0);
+    test_sort_by_key(1);
+    test_sort_by_key(2);
+    test_sort_by_key(1000);
+    test_sort_twice();
+    test_sort_invalid();
+
+    return TEST_RESULT();
+}
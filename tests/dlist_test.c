@@ -0,0 +1,203 @@
+/**************************************************************************
+ *   dlist_test.c  --  This file is part of Data Structures Library.      *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+/*
+ * Inserts, removes and moves doubly linked list nodes at both ends, through indices and cursors,
+ * checking the links in both directions and that the other cursors stay valid.
+ */
+
+#include "../lists/doubly_linked_list.h"
+#include "test_check.h"
+
+/* Walks the list both ways and compares it with @expected */
+static void check_list(const doubly_linked_list* list, const int* expected, const size_t size)
+{
+    CHECK(dlist_size(list) == size);
+    CHECK(dlist_is_empty(list) == (size == 0));
+
+    size_t i = 0;
+    for (const d_node* node = dlist_first_node(list); node; node = dlist_node_next(node))
+    {
+        CHECK((i < size) && (*(const int*)dlist_node_data(node) == expected[i]));
+        i++;
+    }
+    CHECK(i == size);
+
+    for (const d_node* node = dlist_last_node(list); node; node = dlist_node_prev(node))
+    {
+        CHECK((i > 0) && (*(const int*)dlist_node_data(node) == expected[i - 1]));
+        i--;
+    }
+    CHECK(i == 0);
+
+    if (size == 0)
+    {
+        CHECK(!dlist_first_node(list) && !dlist_last_node(list));
+        CHECK(!dlist_get_first(list) && !dlist_get_last(list));
+        return;
+    }
+
+    CHECK(dlist_node_prev(dlist_first_node(list)) == nullptr);
+    CHECK(dlist_node_next(dlist_last_node(list)) == nullptr);
+    CHECK(*(const int*)dlist_get_first(list) == expected[0]);
+    CHECK(*(const int*)dlist_get_last(list) == expected[size - 1]);
+}
+
+static void test_insert_at_ends(void)
+{
+    doubly_linked_list* list = dlist_initialize(sizeof(int));
+    CHECK(list);
+
+    if (!list)
+    {
+        return;
+    }
+
+    /* Into an empty list, where index 0 is both ends */
+    int value = 2;
+    CHECK(dlist_insert(list, 0, &value, sizeof(int)));
+    d_node* middle = dlist_first_node(list);
+    CHECK(middle && (middle == dlist_last_node(list)));
+    check_list(list, (const int[]){2}, 1);
+
+    value = 3;
+    CHECK(dlist_insert(list, dlist_size(list), &value, sizeof(int)));
+    value = 1;
+    CHECK(dlist_insert(list, 0, &value, sizeof(int)));
+    check_list(list, (const int[]){1, 2, 3}, 3);
+
+    value = 0;
+    CHECK(dlist_add_first(list, &value, sizeof(int)));
+    value = 4;
+    CHECK(dlist_add_last(list, &value, sizeof(int)));
+    check_list(list, (const int[]){0, 1, 2, 3, 4}, 5);
+
+    /* Past the end */
+    CHECK(!dlist_insert(list, dlist_size(list) + 1, &value, sizeof(int)));
+
+    /* The first node inserted is still a valid cursor, now in the middle */
+    CHECK(*(const int*)dlist_node_data(middle) == 2);
+    CHECK(*(const int*)dlist_node_data(dlist_node_prev(middle)) == 1);
+    CHECK(*(const int*)dlist_node_data(dlist_node_next(middle)) == 3);
+
+    dlist_destroy(list);
+}
+
+static void test_remove_at_ends(void)
+{
+    doubly_linked_list* list = dlist_initialize(sizeof(int));
+    CHECK(list);
+
+    if (!list)
+    {
+        return;
+    }
+
+    for (int i = 0; i < 5; ++i)
+    {
+        CHECK(dlist_add_last(list, &i, sizeof(int)));
+    }
+
+    d_node* middle = dlist_find_node(list, &(int){2}, sizeof(int));
+    CHECK(middle);
+
+    /* Through cursors on the head and the tail */
+    int* data = dlist_remove_node(list, dlist_first_node(list));
+    CHECK(data && (*data == 0));
+    free(data);
+    data = dlist_remove_node(list, dlist_last_node(list));
+    CHECK(data && (*data == 4));
+    free(data);
+    check_list(list, (const int[]){1, 2, 3}, 3);
+
+    /* Through the end functions */
+    data = dlist_remove_first(list);
+    CHECK(data && (*data == 1));
+    free(data);
+    data = dlist_remove_last(list);
+    CHECK(data && (*data == 3));
+    free(data);
+    check_list(list, (const int[]){2}, 1);
+
+    /* The last node is both ends */
+    CHECK(dlist_first_node(list) == middle);
+    data = dlist_remove_node(list, middle);
+    CHECK(data && (*data == 2));
+    free(data);
+    check_list(list, nullptr, 0);
+
+    CHECK(dlist_remove_first(list) == nullptr);
+    CHECK(dlist_remove_last(list) == nullptr);
+    CHECK(dlist_remove_node(list, nullptr) == nullptr);
+
+    /* The emptied list is usable again */
+    int value = 7;
+    CHECK(dlist_add_first(list, &value, sizeof(int)));
+    check_list(list, (const int[]){7}, 1);
+
+    dlist_destroy(list);
+}
+
+static void test_move_at_ends(void)
+{
+    doubly_linked_list* list = dlist_initialize(sizeof(int));
+    CHECK(list);
+
+    if (!list)
+    {
+        return;
+    }
+
+    int value = 0;
+    CHECK(dlist_add_last(list, &value, sizeof(int)));
+
+    /* A single node is already at both ends */
+    CHECK(dlist_move_to_front(list, dlist_first_node(list)));
+    CHECK(dlist_move_to_back(list, dlist_last_node(list)));
+    check_list(list, (const int[]){0}, 1);
+
+    for (value = 1; value < 4; ++value)
+    {
+        CHECK(dlist_add_last(list, &value, sizeof(int)));
+    }
+
+    d_node* head = dlist_first_node(list);
+    d_node* tail = dlist_last_node(list);
+
+    /* Moving a node to the end it is already at changes nothing */
+    CHECK(dlist_move_to_front(list, head));
+    CHECK(dlist_move_to_back(list, tail));
+    check_list(list, (const int[]){0, 1, 2, 3}, 4);
+
+    /* Swapping ends, the cursors follow their nodes */
+    CHECK(dlist_move_to_front(list, tail));
+    check_list(list, (const int[]){3, 0, 1, 2}, 4);
+    CHECK(dlist_move_to_back(list, head));
+    check_list(list, (const int[]){3, 1, 2, 0}, 4);
+    CHECK((dlist_first_node(list) == tail) && (dlist_last_node(list) == head));
+
+    CHECK(!dlist_move_to_front(list, nullptr));
+    CHECK(!dlist_move_to_back(list, nullptr));
+
+    dlist_destroy(list);
+}
+
+int main(void)
+{
+    test_insert_at_ends();
+    test_remove_at_ends();
+    test_move_at_ends();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,167 @@
+/**************************************************************************
+ *   islist_test.c  --  This file is part of Data Structures Library.     *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+/*
+ * Unlinks intrusive list objects around the tail, and checks that sorting is stable
+ * and leaves the tail on the last object.
+ */
+
+#include "../lists/intrusive_slist.h"
+#include "test_check.h"
+
+#define ISLIST_TEST_OBJECTS 1000
+
+typedef struct test_object
+{
+    int key;
+    /* The insertion order, to check stability */
+    size_t sequence;
+    islist_link link;
+} test_object;
+
+static int compare_objects(const void* a, const void* b)
+{
+    const test_object* x = a;
+    const test_object* y = b;
+    return (x->key > y->key) - (x->key < y->key);
+}
+
+/* Walks the list, comparing its objects with @expected, and checks the last one is the tail */
+static void check_list(const intrusive_slist* list, test_object* const* expected, const size_t size)
+{
+    CHECK(islist_size(list) == size);
+    CHECK(islist_is_empty(list) == (size == 0));
+
+    size_t i = 0;
+    test_object* last = nullptr;
+    for (test_object* object = islist_get_first(list); object; object = islist_next(list, object))
+    {
+        CHECK((i < size) && (object == expected[i]));
+        last = object;
+        i++;
+    }
+
+    CHECK(i == size);
+    CHECK(islist_get_last(list) == last);
+}
+
+static void test_remove_after_tail(void)
+{
+    intrusive_slist* list = islist_initialize(ISLIST_OFFSET(test_object, link));
+    CHECK(list);
+
+    if (!list)
+    {
+        return;
+    }
+
+    test_object objects[4] = {{0}};
+    for (size_t i = 0; i < 4; ++i)
+    {
+        objects[i].sequence = i;
+        CHECK(islist_push_last(list, &objects[i]));
+    }
+
+    /* Nothing follows the tail */
+    CHECK(islist_remove_after(list, &objects[3]) == nullptr);
+    check_list(list, (test_object* const[]){&objects[0], &objects[1], &objects[2], &objects[3]}, 4);
+
+    /* Unlinking the tail moves the tail back to the object before it */
+    CHECK(islist_remove_after(list, &objects[2]) == &objects[3]);
+    check_list(list, (test_object* const[]){&objects[0], &objects[1], &objects[2]}, 3);
+    CHECK(objects[2].link.next == nullptr);
+
+    /* The next object pushed last follows the new tail */
+    CHECK(islist_push_last(list, &objects[3]));
+    check_list(list, (test_object* const[]){&objects[0], &objects[1], &objects[2], &objects[3]}, 4);
+
+    /* Unlinking the only object empties the list */
+    CHECK(islist_remove_after(list, &objects[0]) == &objects[1]);
+    CHECK(islist_remove_after(list, &objects[0]) == &objects[2]);
+    CHECK(islist_remove_after(list, &objects[0]) == &objects[3]);
+    CHECK(islist_remove_after(list, nullptr) == &objects[0]);
+    check_list(list, nullptr, 0);
+    CHECK(islist_remove_after(list, nullptr) == nullptr);
+    CHECK(islist_pop_first(list) == nullptr);
+
+    CHECK(islist_push_last(list, &objects[1]));
+    CHECK(islist_push_first(list, &objects[0]));
+    check_list(list, (test_object* const[]){&objects[0], &objects[1]}, 2);
+
+    islist_destroy(list);
+}
+
+static void test_sort_stable(const size_t size, const int keys)
+{
+    intrusive_slist* list = islist_initialize(ISLIST_OFFSET(test_object, link));
+    test_object* objects = calloc(size ? size : 1, sizeof(test_object));
+    test_object** expected = calloc(size ? size : 1, sizeof(test_object*));
+    CHECK(list && objects && expected);
+
+    if (!list || !objects || !expected)
+    {
+        islist_destroy(list);
+        free(objects);
+        free(expected);
+        return;
+    }
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        objects[i].key = (int)((i * 7919) % (size_t)keys);
+        objects[i].sequence = i;
+        CHECK(islist_push_last(list, &objects[i]));
+    }
+
+    islist_sort(list, compare_objects);
+
+    /* The expected order groups the objects by key, in insertion order within a key */
+    size_t count = 0;
+    for (int key = 0; key < keys; ++key)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (objects[i].key == key)
+            {
+                expected[count++] = &objects[i];
+            }
+        }
+    }
+
+    check_list(list, expected, size);
+
+    /* The tail was left on the last sorted object */
+    test_object extra = {.key = keys, .sequence = size};
+    CHECK(islist_push_last(list, &extra));
+    CHECK(islist_get_last(list) == &extra);
+    CHECK(islist_size(list) == size + 1);
+
+    islist_destroy(list);
+    free(objects);
+    free(expected);
+}
+
+int main(void)
+{
+    test_remove_after_tail();
+
+    const size_t sizes[] = {0, 1, 2, 3, 17, ISLIST_TEST_OBJECTS};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+        test_sort_stable(sizes[i], 1);
+        test_sort_stable(sizes[i], 7);
+    }
+
+    return TEST_RESULT();
+}
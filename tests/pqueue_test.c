@@ -0,0 +1,269 @@
+/**************************************************************************
+ *   pqueue_test.c  --  This file is part of Data Structures Library.     *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+/*
+ * Updates and removes priority queue elements through their handles, at the root,
+ * at the leaves and in between, and checks the queue against a plain array of the live elements.
+ */
+
+#include "../lists/priority_queue.h"
+#include "test_check.h"
+
+#define PQUEUE_TEST_ITEMS 500
+
+typedef struct test_item
+{
+    uint32_t key;
+    uint32_t id;
+} test_item;
+
+static int compare_items(const void* a, const void* b)
+{
+    const test_item* x = a;
+    const test_item* y = b;
+    return (x->key > y->key) - (x->key < y->key);
+}
+
+static uint64_t next_random(uint64_t* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/* Pops every element, checking they come out in order and match the keys of the live ids */
+static void check_drain(priority_queue* queue, const uint32_t* keys, bool* live, const size_t count)
+{
+    size_t expected = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        expected += live[i];
+    }
+    CHECK(pqueue_size(queue) == expected);
+
+    test_item item;
+    uint32_t previous = 0;
+
+    while (pqueue_pop(queue, &item, sizeof(test_item)))
+    {
+        CHECK(item.key >= previous);
+        CHECK((item.id < count) && live[item.id] && (keys[item.id] == item.key));
+        previous = item.key;
+
+        if (item.id < count)
+        {
+            live[item.id] = false;
+        }
+
+        expected--;
+    }
+
+    CHECK(expected == 0);
+    CHECK(pqueue_is_empty(queue));
+}
+
+static void test_update(const size_t arity)
+{
+    priority_queue* queue = pqueue_initialize_with_handles(sizeof(test_item), arity, compare_items);
+    CHECK(queue);
+
+    if (!queue)
+    {
+        return;
+    }
+
+    uint32_t keys[PQUEUE_TEST_ITEMS];
+    bool live[PQUEUE_TEST_ITEMS];
+    size_t handles[PQUEUE_TEST_ITEMS];
+
+    for (uint32_t i = 0; i < PQUEUE_TEST_ITEMS; ++i)
+    {
+        const test_item item = {1000 + ((i * 7919) % PQUEUE_TEST_ITEMS), i};
+        CHECK(pqueue_push_handle(queue, &item, sizeof(test_item), &handles[i]));
+        keys[i] = item.key;
+        live[i] = true;
+    }
+
+    /* Decreasing the last pushed element's key moves it from a leaf to the root */
+    const uint32_t last = PQUEUE_TEST_ITEMS - 1;
+    test_item item = {1, last};
+    CHECK(pqueue_update(queue, handles[last], &item, sizeof(test_item)));
+    keys[last] = item.key;
+
+    test_item top;
+    CHECK(pqueue_peek(queue, &top, sizeof(test_item)) && (top.id == last));
+
+    /* Increasing the root's key moves it down to a leaf */
+    item = (test_item){5000, last};
+    CHECK(pqueue_update(queue, handles[last], &item, sizeof(test_item)));
+    keys[last] = item.key;
+    CHECK(pqueue_peek(queue, &top, sizeof(test_item)) && (top.id != last));
+
+    /* Keys of elements in the middle of the heap, in both directions */
+    for (uint32_t i = 0; i < PQUEUE_TEST_ITEMS; i += 3)
+    {
+        item = (test_item){(i % 2) ? keys[i] + 700 : keys[i] - 700, i};
+        CHECK(pqueue_update(queue, handles[i], &item, sizeof(test_item)));
+        keys[i] = item.key;
+    }
+
+    /* An update with the same key leaves the element in place */
+    item = (test_item){keys[1], 1};
+    CHECK(pqueue_update(queue, handles[1], &item, sizeof(test_item)));
+
+    CHECK(!pqueue_update(queue, handles[0], &item, sizeof(uint32_t)));
+
+    check_drain(queue, keys, live, PQUEUE_TEST_ITEMS);
+    CHECK(!pqueue_contains_handle(queue, handles[0]));
+    CHECK(!pqueue_update(queue, handles[0], &item, sizeof(test_item)));
+
+    pqueue_destroy(queue);
+}
+
+static void test_remove(const size_t arity)
+{
+    priority_queue* queue = pqueue_initialize_with_handles(sizeof(test_item), arity, compare_items);
+    CHECK(queue);
+
+    if (!queue)
+    {
+        return;
+    }
+
+    uint32_t keys[PQUEUE_TEST_ITEMS];
+    bool live[PQUEUE_TEST_ITEMS];
+    size_t handles[PQUEUE_TEST_ITEMS];
+
+    for (uint32_t i = 0; i < PQUEUE_TEST_ITEMS; ++i)
+    {
+        const test_item item = {(i * 7919) % PQUEUE_TEST_ITEMS, i};
+        CHECK(pqueue_push_handle(queue, &item, sizeof(test_item), &handles[i]));
+        keys[i] = item.key;
+        live[i] = true;
+    }
+
+    /* The root */
+    test_item top;
+    test_item removed;
+    CHECK(pqueue_peek(queue, &top, sizeof(test_item)));
+    CHECK(pqueue_remove(queue, handles[top.id], &removed, sizeof(test_item)));
+    CHECK((removed.id == top.id) && (removed.key == top.key));
+    CHECK(!pqueue_contains_handle(queue, handles[top.id]));
+    live[top.id] = false;
+
+    /* The last element, which is a leaf */
+    const uint32_t last = PQUEUE_TEST_ITEMS - 1;
+    CHECK(pqueue_remove(queue, handles[last], &removed, sizeof(test_item)) && (removed.id == last));
+    live[last] = false;
+
+    /* A removed handle cannot be removed twice */
+    CHECK(!pqueue_remove(queue, handles[last], &removed, sizeof(test_item)));
+
+    /* Elements in between */
+    for (uint32_t i = 1; i < last; i += 4)
+    {
+        if (live[i])
+        {
+            CHECK(pqueue_remove(queue, handles[i], &removed, sizeof(test_item)));
+            CHECK((removed.id == i) && (removed.key == keys[i]));
+            live[i] = false;
+        }
+    }
+
+    for (uint32_t i = 0; i < PQUEUE_TEST_ITEMS; ++i)
+    {
+        CHECK(pqueue_contains_handle(queue, handles[i]) == live[i]);
+    }
+
+    check_drain(queue, keys, live, PQUEUE_TEST_ITEMS);
+    pqueue_destroy(queue);
+}
+
+/* Random pushes, pops, updates and removes, checked against the live keys */
+static void test_random(const size_t arity)
+{
+    priority_queue* queue = pqueue_initialize_with_handles(sizeof(test_item), arity, compare_items);
+    CHECK(queue);
+
+    if (!queue)
+    {
+        return;
+    }
+
+    uint32_t keys[PQUEUE_TEST_ITEMS];
+    bool live[PQUEUE_TEST_ITEMS] = {false};
+    size_t handles[PQUEUE_TEST_ITEMS];
+    uint32_t count = 0;
+    uint64_t state = 88172645463325252ULL + arity;
+
+    for (size_t step = 0; step < 20000; ++step)
+    {
+        const uint64_t operation = next_random(&state) % 5;
+        const uint32_t id = count ? (uint32_t)(next_random(&state) % count) : 0;
+        const uint32_t key = (uint32_t)(next_random(&state) % 1000);
+
+        if ((operation <= 1) && (count < PQUEUE_TEST_ITEMS))
+        {
+            const test_item item = {key, count};
+            CHECK(pqueue_push_handle(queue, &item, sizeof(test_item), &handles[count]));
+            keys[count] = key;
+            live[count] = true;
+            count++;
+        }
+        else if (operation == 2)
+        {
+            test_item item;
+            if (pqueue_pop(queue, &item, sizeof(test_item)))
+            {
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    CHECK(!live[i] || (keys[i] >= item.key));
+                }
+
+                CHECK((item.id < count) && live[item.id] && (keys[item.id] == item.key));
+                live[item.id] = false;
+            }
+        }
+        else if ((operation == 3) && count && live[id])
+        {
+            const test_item item = {key, id};
+            CHECK(pqueue_update(queue, handles[id], &item, sizeof(test_item)));
+            keys[id] = key;
+        }
+        else if ((operation == 4) && count && live[id])
+        {
+            test_item item;
+            CHECK(pqueue_remove(queue, handles[id], &item, sizeof(test_item)) && (item.id == id));
+            live[id] = false;
+        }
+    }
+
+    check_drain(queue, keys, live, count);
+    pqueue_destroy(queue);
+}
+
+int main(void)
+{
+    const size_t arities[] = {2, 3, 4, 8};
+
+    for (size_t i = 0; i < sizeof(arities) / sizeof(arities[0]); ++i)
+    {
+        test_update(arities[i]);
+        test_remove(arities[i]);
+        test_random(arities[i]);
+    }
+
+    return TEST_RESULT();
+}
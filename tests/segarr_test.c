@@ -0,0 +1,176 @@
+/**************************************************************************
+ *   segarr_test.c  --  This file is part of Data Structures Library.     *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+/*
+ * Grows a segmented array across several block boundaries, checking that the elements
+ * keep their values and addresses, and that removing and sorting work across blocks.
+ */
+
+#include "../lists/segmented_array.h"
+#include "test_check.h"
+
+/* Enough elements to fill eight blocks */
+#define SEGARR_TEST_SIZE ((size_t)SEGARR_FIRST_BLOCK_CAPACITY * 255)
+
+static int compare_uint64(const void* a, const void* b)
+{
+    const uint64_t x = *(const uint64_t*)a;
+    const uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* Whether @index is the first element of a block */
+static bool is_block_start(const size_t index)
+{
+    for (size_t end = SEGARR_FIRST_BLOCK_CAPACITY; end <= index; end = (end * 2) + SEGARR_FIRST_BLOCK_CAPACITY)
+    {
+        if (end == index)
+        {
+            return true;
+        }
+    }
+
+    return index == 0;
+}
+
+static void test_growth_keeps_addresses(void)
+{
+    segmented_array* list = segarr_initialize(sizeof(uint64_t));
+    uint64_t** addresses = calloc(SEGARR_TEST_SIZE, sizeof(uint64_t*));
+    CHECK(list && addresses);
+
+    if (!list || !addresses)
+    {
+        segarr_destroy(list);
+        free(addresses);
+        return;
+    }
+
+    size_t blocks = 0;
+
+    for (size_t i = 0; i < SEGARR_TEST_SIZE; ++i)
+    {
+        const uint64_t value = i;
+        CHECK(segarr_add(list, &value, sizeof(uint64_t)));
+        CHECK(segarr_size(list) == i + 1);
+
+        addresses[i] = segarr_get_at(list, i);
+        CHECK(addresses[i] && (*addresses[i] == i));
+
+        if (is_block_start(i))
+        {
+            blocks++;
+
+            /* The last element of the previous block did not move when this one was allocated */
+            CHECK((i == 0) || (segarr_get_at(list, i - 1) == addresses[i - 1]));
+        }
+    }
+
+    CHECK(blocks == 8);
+    CHECK(segarr_get_at(list, SEGARR_TEST_SIZE) == nullptr);
+
+    for (size_t i = 0; i < SEGARR_TEST_SIZE; ++i)
+    {
+        uint64_t value = UINT64_MAX;
+        CHECK(segarr_get(list, i, &value, sizeof(uint64_t)) && (value == i));
+        CHECK(segarr_get_at(list, i) == addresses[i]);
+        CHECK(*addresses[i] == i);
+    }
+
+    segarr_destroy(list);
+    free(addresses);
+}
+
+static void test_remove_across_boundary(void)
+{
+    segmented_array* list = segarr_initialize(sizeof(uint64_t));
+    CHECK(list);
+
+    if (!list)
+    {
+        return;
+    }
+
+    const size_t size = SEGARR_FIRST_BLOCK_CAPACITY * 7;
+    for (uint64_t i = 0; i < size; ++i)
+    {
+        CHECK(segarr_add(list, &i, sizeof(uint64_t)));
+    }
+
+    /* The last element of the first block, so every later element moves back across two boundaries */
+    uint64_t removed = UINT64_MAX;
+    CHECK(segarr_remove_at(list, SEGARR_FIRST_BLOCK_CAPACITY - 1, &removed, sizeof(uint64_t)));
+    CHECK(removed == SEGARR_FIRST_BLOCK_CAPACITY - 1);
+    CHECK(segarr_size(list) == size - 1);
+
+    for (size_t i = 0; i < size - 1; ++i)
+    {
+        uint64_t value = UINT64_MAX;
+        CHECK(segarr_get(list, i, &value, sizeof(uint64_t)));
+        CHECK(value == ((i < SEGARR_FIRST_BLOCK_CAPACITY - 1) ? i : i + 1));
+    }
+
+    /* Growing again after trimming refills the freed block */
+    segarr_trim_to_size(list);
+    const uint64_t last = size;
+    CHECK(segarr_add(list, &last, sizeof(uint64_t)));
+    CHECK(segarr_size(list) == size);
+    CHECK(*(const uint64_t*)segarr_get_at(list, size - 1) == last);
+
+    segarr_destroy(list);
+}
+
+static void test_sort(void)
+{
+    segmented_array* list = segarr_initialize(sizeof(uint64_t));
+    CHECK(list);
+
+    if (!list)
+    {
+        return;
+    }
+
+    const size_t size = SEGARR_FIRST_BLOCK_CAPACITY * 31;
+    for (size_t i = 0; i < size; ++i)
+    {
+        /* A permutation of 0..size-1, as 7919 is prime and does not divide size */
+        const uint64_t value = (i * 7919) % size;
+        CHECK(segarr_add(list, &value, sizeof(uint64_t)));
+    }
+
+    segarr_sort(list, compare_uint64);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        uint64_t value = UINT64_MAX;
+        CHECK(segarr_get(list, i, &value, sizeof(uint64_t)) && (value == i));
+    }
+
+    ds_stats stats;
+    if (segarr_get_stats(list, &stats))
+    {
+        CHECK(stats.comparisons > 0);
+    }
+
+    segarr_destroy(list);
+}
+
+int main(void)
+{
+    test_growth_keeps_addresses();
+    test_remove_across_boundary();
+    test_sort();
+
+    return TEST_RESULT();
+}
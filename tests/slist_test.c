@@ -0,0 +1,192 @@
+/**************************************************************************
+ *   slist_test.c  --  This file is part of Data Structures Library.      *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+/*
+ * Splits and splices singly linked lists at index 0, in the middle and at their size,
+ * checking the elements and that both lists keep appending at their own tail.
+ */
+
+#include "../lists/singly_linked_list.h"
+#include "test_check.h"
+
+/* Appends first..last-1 */
+static void fill(singly_linked_list* list, const int first, const int last)
+{
+    for (int i = first; i < last; ++i)
+    {
+        CHECK(slist_add_last(list, &i, sizeof(int)));
+    }
+}
+
+/* Compares a list with @expected, and checks that appending lands after its last element */
+static void check_list(singly_linked_list* list, const int* expected, const size_t size)
+{
+    CHECK(slist_size(list) == size);
+    CHECK(slist_is_empty(list) == (size == 0));
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        const int* value = slist_get_at(list, i);
+        CHECK(value && (*value == expected[i]));
+    }
+
+    if (size == 0)
+    {
+        CHECK(!slist_get_first(list) && !slist_get_last(list));
+    }
+    else
+    {
+        CHECK(*(const int*)slist_get_last(list) == expected[size - 1]);
+    }
+
+    const int sentinel = -1;
+    CHECK(slist_add_last(list, &sentinel, sizeof(int)));
+    CHECK((slist_size(list) == size + 1) && (*(const int*)slist_get_last(list) == sentinel));
+    CHECK(*(const int*)slist_get_at(list, size) == sentinel);
+
+    int* removed = slist_remove_last(list);
+    CHECK(removed && (*removed == sentinel));
+    free(removed);
+}
+
+static void test_split_at(void)
+{
+    singly_linked_list* list = slist_initialize(sizeof(int));
+    CHECK(list);
+
+    if (!list)
+    {
+        return;
+    }
+
+    fill(list, 0, 6);
+
+    /* At the size, the new list is empty and the list keeps every node */
+    singly_linked_list* end = slist_split_at(list, slist_size(list));
+    CHECK(end);
+    check_list(list, (const int[]){0, 1, 2, 3, 4, 5}, 6);
+    check_list(end, nullptr, 0);
+
+    /* Past the size */
+    CHECK(slist_split_at(list, slist_size(list) + 1) == nullptr);
+
+    /* In the middle */
+    singly_linked_list* back = slist_split_at(list, 4);
+    CHECK(back);
+    check_list(list, (const int[]){0, 1, 2, 3}, 4);
+    check_list(back, (const int[]){4, 5}, 2);
+
+    /* At 0, every node moves and the list is left empty */
+    singly_linked_list* all = slist_split_at(list, 0);
+    CHECK(all);
+    check_list(list, nullptr, 0);
+    check_list(all, (const int[]){0, 1, 2, 3}, 4);
+
+    /* An empty list splits at 0 into two empty lists */
+    singly_linked_list* none = slist_split_at(list, 0);
+    CHECK(none);
+    check_list(list, nullptr, 0);
+    check_list(none, nullptr, 0);
+
+    slist_destroy(list);
+    slist_destroy(end);
+    slist_destroy(back);
+    slist_destroy(all);
+    slist_destroy(none);
+}
+
+static void test_splice_at(void)
+{
+    singly_linked_list* list = slist_initialize(sizeof(int));
+    singly_linked_list* other = slist_initialize(sizeof(int));
+    singly_linked_list* wide = slist_initialize(sizeof(long long));
+    CHECK(list && other && wide);
+
+    if (!list || !other || !wide)
+    {
+        slist_destroy(list);
+        slist_destroy(other);
+        slist_destroy(wide);
+        return;
+    }
+
+    /* Into an empty list, where index 0 is also the size */
+    fill(other, 10, 12);
+    CHECK(slist_splice_at(list, 0, other));
+    check_list(list, (const int[]){10, 11}, 2);
+    check_list(other, nullptr, 0);
+
+    /* At 0 */
+    fill(other, 0, 2);
+    CHECK(slist_splice_at(list, 0, other));
+    check_list(list, (const int[]){0, 1, 10, 11}, 4);
+    check_list(other, nullptr, 0);
+
+    /* At the size, the spliced nodes become the tail */
+    fill(other, 20, 22);
+    CHECK(slist_splice_at(list, slist_size(list), other));
+    check_list(list, (const int[]){0, 1, 10, 11, 20, 21}, 6);
+    check_list(other, nullptr, 0);
+
+    /* An empty list splices as a no-op at both ends */
+    CHECK(slist_splice_at(list, 0, other));
+    CHECK(slist_splice_at(list, slist_size(list), other));
+    check_list(list, (const int[]){0, 1, 10, 11, 20, 21}, 6);
+
+    /* Rejected: past the size, a list into itself and another data size */
+    fill(other, 30, 31);
+    CHECK(!slist_splice_at(list, slist_size(list) + 1, other));
+    CHECK(!slist_splice_at(list, 0, list));
+    CHECK(!slist_splice_at(wide, 0, other));
+    check_list(list, (const int[]){0, 1, 10, 11, 20, 21}, 6);
+    check_list(other, (const int[]){30}, 1);
+
+    slist_destroy(list);
+    slist_destroy(other);
+    slist_destroy(wide);
+}
+
+static void test_split_splice_round_trip(void)
+{
+    singly_linked_list* list = slist_initialize(sizeof(int));
+    CHECK(list);
+
+    if (!list)
+    {
+        return;
+    }
+
+    fill(list, 0, 8);
+
+    /* Splitting at every index and splicing the nodes back restores the list */
+    for (size_t index = 0; index <= 8; ++index)
+    {
+        singly_linked_list* back = slist_split_at(list, index);
+        CHECK(back && (slist_size(list) == index) && (slist_size(back) == 8 - index));
+        CHECK(slist_splice_at(list, index, back));
+        check_list(list, (const int[]){0, 1, 2, 3, 4, 5, 6, 7}, 8);
+        slist_destroy(back);
+    }
+
+    slist_destroy(list);
+}
+
+int main(void)
+{
+    test_split_at();
+    test_splice_at();
+    test_split_splice_round_trip();
+
+    return TEST_RESULT();
+}
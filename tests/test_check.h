@@ -0,0 +1,42 @@
+/**************************************************************************
+ *   test_check.h  --  This file is part of Data Structures Library.      *
+ *                                                                        *
+ *   Copyright (C) 2025 Ahmad Al Rabia.                                   *
+ *                                                                        *
+ *   Data Structures Library is free software: you can redistribute it    *
+ *   and/or modify it.                                                    *
+ *                                                                        *
+ *   Data Structures Library is distributed in the hope that it will be   *
+ *   useful, but WITHOUT ANY WARRANTY; without even the implied warranty  *
+ *   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.              *
+ *                                                                        *
+ **************************************************************************/
+
+#ifndef _DATASTRUCTURES_TEST_CHECK_H
+#define _DATASTRUCTURES_TEST_CHECK_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * The checks of the tests. Unlike assert() they are kept in release builds,
+ * and a failed check is reported without stopping the test, which exits with TEST_RESULT().
+ */
+
+static int test_failures;
+
+#define CHECK(condition)                                                                    \
+    do                                                                                      \
+    {                                                                                       \
+        if (!(condition))                                                                   \
+        {                                                                                   \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            test_failures++;                                                                \
+        }                                                                                   \
+    }                                                                                       \
+    while (0)
+
+/* The exit status of a test */
+#define TEST_RESULT() ((test_failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE)
+
+#endif //_DATASTRUCTURES_TEST_CHECK_H